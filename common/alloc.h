@@ -0,0 +1,190 @@
+#pragma once
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <ostream>
+#include <iomanip>
+#include <vector>
+#include <string_view>
+#include <algorithm>
+
+#ifdef AOC_TRACK_ALLOCS
+#include <malloc.h>
+#endif
+
+// Replaces the global operator new/delete to count heap allocations. Must only
+// be included by a single translation unit per program (every day is built as
+// one).
+//
+// Building with -DAOC_TRACK_ALLOCS additionally tracks the live heap, which
+// gives the peak heap of every benchmarked phase, and enables AOC_ALLOC_SCOPE
+// for totals of named regions of code. Without it the scopes compile to nothing.
+
+namespace aoc {
+
+#ifdef AOC_TRACK_ALLOCS
+inline constexpr bool TRACK_ALLOCS = true;
+#else
+inline constexpr bool TRACK_ALLOCS = false;
+#endif
+
+struct Allocations {
+  size_t count{};
+  size_t bytes{};
+};
+
+namespace detail {
+inline std::atomic<size_t> allocationCount{};
+inline std::atomic<size_t> allocationBytes{};
+inline std::atomic<size_t> liveBytes{};
+inline std::atomic<size_t> peakBytes{};
+
+inline void raisePeak(size_t bytes) {
+  size_t peak = peakBytes.load(std::memory_order_relaxed);
+  while (bytes > peak && !peakBytes.compare_exchange_weak(peak, bytes, std::memory_order_relaxed)) {
+  }
+}
+}
+
+// Totals since program start, differences give the cost of a region of code
+inline Allocations allocations() {
+  return {detail::allocationCount.load(std::memory_order_relaxed), detail::allocationBytes.load(std::memory_order_relaxed)};
+}
+
+// Heap in use right now, always 0 unless tracking
+inline size_t liveBytes() {
+  return detail::liveBytes.load(std::memory_order_relaxed);
+}
+
+// Allocations and peak heap between construction and finish. Regions nest, the
+// peak of an enclosing region still includes everything reached inside.
+// Concurrent regions on other threads show up in each other's numbers.
+class AllocRegion {
+public:
+  struct Result {
+    Allocations allocated;
+    size_t peakBytes{}; // Above the heap in use at the start
+  };
+
+  AllocRegion() : start(allocations()), startLive(liveBytes()), outerPeak(detail::peakBytes.exchange(startLive, std::memory_order_relaxed)) {}
+
+  // Call once, at the end of the region
+  Result finish() {
+    const auto end = allocations();
+    const auto peak = detail::peakBytes.load(std::memory_order_relaxed);
+    detail::raisePeak(outerPeak);
+    return {{end.count - start.count, end.bytes - start.bytes}, peak > startLive ? peak - startLive : 0};
+  }
+
+private:
+  const Allocations start;
+  const size_t startLive;
+  const size_t outerPeak;
+};
+
+// Totals of a named region over all of its runs. Every scope is a static that
+// links itself into a list on first use, so recording never allocates.
+class AllocScope {
+public:
+  explicit AllocScope(const char* name) : name(name), next(head.load()) {
+    while (!head.compare_exchange_weak(next, this)) {
+    }
+  }
+
+  void record(const AllocRegion::Result& result) {
+    runs.fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(result.allocated.count, std::memory_order_relaxed);
+    bytes.fetch_add(result.allocated.bytes, std::memory_order_relaxed);
+    size_t current = peak.load(std::memory_order_relaxed);
+    while (result.peakBytes > current && !peak.compare_exchange_weak(current, result.peakBytes, std::memory_order_relaxed)) {
+    }
+  }
+
+  // Every scope that ran, by name. A scope running inside itself (recursion)
+  // counts the allocations of the inner runs again in the outer ones.
+  static void report(std::ostream& os) {
+    std::vector<const AllocScope*> scopes;
+    for (const auto* scope = head.load(); scope; scope = scope->next)
+      scopes.push_back(scope);
+    std::ranges::sort(scopes, {}, [](const auto* scope) { return std::string_view(scope->name); });
+
+    os << std::left << std::setw(20) << "scope" << std::right << std::setw(14) << "runs" << std::setw(14) << "allocs"
+       << std::setw(16) << "alloc bytes" << std::setw(16) << "peak bytes" << '\n';
+    for (const auto* scope : scopes) {
+      os << std::left << std::setw(20) << scope->name << std::right << std::setw(14) << scope->runs << std::setw(14) << scope->count
+         << std::setw(16) << scope->bytes << std::setw(16) << scope->peak << '\n';
+    }
+  }
+
+private:
+  static inline std::atomic<AllocScope*> head{};
+
+  const char* const name;
+  AllocScope* next;
+  std::atomic<size_t> runs{};
+  std::atomic<size_t> count{};
+  std::atomic<size_t> bytes{};
+  std::atomic<size_t> peak{};
+};
+
+// Records the enclosing block into a scope when it ends
+class AllocScopeGuard {
+public:
+  explicit AllocScopeGuard(AllocScope& scope) : scope(scope) {}
+
+  AllocScopeGuard(const AllocScopeGuard&) = delete;
+  AllocScopeGuard& operator=(const AllocScopeGuard&) = delete;
+
+  ~AllocScopeGuard() {
+    scope.record(region.finish());
+  }
+
+private:
+  AllocScope& scope;
+  AllocRegion region;
+};
+
+}
+
+#define AOC_CONCAT_IMPL(a, b) a##b
+#define AOC_CONCAT(a, b) AOC_CONCAT_IMPL(a, b)
+
+// Counts allocations from here to the end of the block under the given name
+#ifdef AOC_TRACK_ALLOCS
+#define AOC_ALLOC_SCOPE(name) \
+  static aoc::AllocScope AOC_CONCAT(allocScope, __LINE__)(name); \
+  const aoc::AllocScopeGuard AOC_CONCAT(allocScopeGuard, __LINE__)(AOC_CONCAT(allocScope, __LINE__))
+#else
+#define AOC_ALLOC_SCOPE(name)
+#endif
+
+void* operator new(size_t size) {
+  aoc::detail::allocationCount.fetch_add(1, std::memory_order_relaxed);
+  aoc::detail::allocationBytes.fetch_add(size, std::memory_order_relaxed);
+
+  if (void* ptr = std::malloc(size ? size : 1)) {
+#ifdef AOC_TRACK_ALLOCS
+    const size_t usable = malloc_usable_size(ptr);
+    aoc::detail::raisePeak(aoc::detail::liveBytes.fetch_add(usable, std::memory_order_relaxed) + usable);
+#endif
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void operator delete(void* ptr) noexcept {
+#ifdef AOC_TRACK_ALLOCS
+  if (ptr)
+    aoc::detail::liveBytes.fetch_sub(malloc_usable_size(ptr), std::memory_order_relaxed);
+#endif
+  std::free(ptr);
+}
+
+[[gnu::noinline]] void operator delete(void* ptr, [[maybe_unused]] size_t size) noexcept {
+#ifdef AOC_TRACK_ALLOCS
+  if (ptr)
+    aoc::detail::liveBytes.fetch_sub(malloc_usable_size(ptr), std::memory_order_relaxed);
+#endif
+  std::free(ptr);
+}
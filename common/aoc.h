@@ -0,0 +1,172 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <optional>
+#include <map>
+#include <type_traits>
+
+#include "alloc.h"
+#include "bench.h"
+#include "input.h"
+
+namespace aoc {
+
+// Placeholder for days that only have one part
+struct NoPart {};
+
+// A day split into its callable units: parse builds the model from the input,
+// part1 and part2 solve on it without modifying it.
+template <class Parse, class Part1, class Part2 = NoPart>
+struct Solver {
+  Parse parse;
+  Part1 part1;
+  Part2 part2{};
+
+  static constexpr bool HAS_PART2 = !std::is_same_v<Part2, NoPart>;
+};
+
+// Command line of the form [--flag | --key=value]... [input]
+class Options {
+public:
+  Options() = default;
+
+  Options(int argc, char* argv[]) {
+    if (argc > 0) {
+      std::string_view path = argv[0];
+      program = path.substr(path.find_last_of('/') + 1);
+    }
+
+    for (int i = 1; i < argc; i++) {
+      std::string_view arg = argv[i];
+      if (arg.starts_with("--")) {
+        arg.remove_prefix(2);
+        const auto equals = arg.find('=');
+        values[std::string(arg.substr(0, equals))] = equals == std::string_view::npos ? "" : arg.substr(equals + 1);
+      } else {
+        input = arg;
+      }
+    }
+  }
+
+  bool has(const std::string& key) const {
+    return values.count(key);
+  }
+
+  unsigned get(const std::string& key, unsigned fallback) const {
+    const auto found = values.find(key);
+    return found == values.end() || found->second.empty() ? fallback : std::stoul(found->second);
+  }
+
+  std::string get(const std::string& key, const std::string& fallback) const {
+    const auto found = values.find(key);
+    return found == values.end() || found->second.empty() ? fallback : found->second;
+  }
+
+  std::string program;
+  std::string input; // Empty when reading standard input
+
+private:
+  std::map<std::string, std::string> values;
+};
+
+// Options of the running program, for days with settings of their own
+inline Options options;
+
+// The input file given in the options, or standard input without one. Says
+// which could not be read when it fails.
+inline std::optional<Input> openInput() {
+  auto input = options.input.empty() ? Input::read(STDIN_FILENO) : Input::open(options.input);
+  if (!input)
+    std::cerr << "Unable to read " << (options.input.empty() ? "standard input" : options.input) << '\n';
+  return input;
+}
+
+// Opens the input file given in the options, or standard input without one,
+// for read to go through as it likes, false when reading fails. Says which
+// could not be read when it fails.
+template <class F>
+bool readInput(F&& read) {
+  const int fd = options.input.empty() ? STDIN_FILENO : ::open(options.input.c_str(), O_RDONLY);
+  const bool done = fd >= 0 && read(fd);
+  if (!options.input.empty() && fd >= 0)
+    ::close(fd);
+  if (!done)
+    std::cerr << "Unable to read " << (options.input.empty() ? "standard input" : options.input) << '\n';
+  return done;
+}
+
+// The input a batch of lines at a time as it is read, see readLines
+template <class F>
+bool readInputLines(F&& f) {
+  return readInput([&f](int fd) { return readLines(fd, f); });
+}
+
+// The input a block at a time as it is read, see readBlocks
+template <class F>
+bool readInputBlocks(F&& f) {
+  return readInput([&f](int fd) { return readBlocks(fd, f); });
+}
+
+template <class S>
+auto parse(const S& solver, std::string_view input) {
+  return solver.parse(input);
+}
+
+template <class S>
+void bench(const S& solver, std::string_view input) {
+  Bench bench(options.program, input.size(), options.get("warmup", 1), options.get("iterations", 10));
+
+  bench.measure("parse", [&]() { return parse(solver, input); });
+
+  const auto model = parse(solver, input);
+  bench.measure("part1", [&]() { return solver.part1(model); });
+  if constexpr (S::HAS_PART2)
+    bench.measure("part2", [&]() { return solver.part2(model); });
+
+  if (options.has("json"))
+    bench.printJson(std::cout);
+  else
+    bench.printTable(std::cout);
+
+  if constexpr (TRACK_ALLOCS)
+    AllocScope::report(std::cerr);
+}
+
+// Entry point shared by all days. Solves the input from the file given on the
+// command line or from standard input, or benchmarks the solver with --bench.
+// When tracking allocations, the scopes of every phase go to standard error.
+template <class S>
+int main(int argc, char* argv[], const S& solver) {
+  options = Options(argc, argv);
+
+  const auto input = openInput();
+  if (!input)
+    return 1;
+
+  if (options.has("bench")) {
+    bench(solver, input->view());
+    return 0;
+  }
+
+  const auto model = [&]() {
+    AOC_ALLOC_SCOPE("parse");
+    return parse(solver, input->view());
+  }();
+  {
+    AOC_ALLOC_SCOPE("part1");
+    std::cout << "Part 1 result = " << solver.part1(model) << '\n';
+  }
+  if constexpr (S::HAS_PART2) {
+    AOC_ALLOC_SCOPE("part2");
+    std::cout << "Part 2 result = " << solver.part2(model) << '\n';
+  }
+
+  if constexpr (TRACK_ALLOCS)
+    AllocScope::report(std::cerr);
+
+  return 0;
+}
+
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <array>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+
+#include "alloc.h"
+
+namespace aoc {
+
+// Keeps the compiler from discarding a result that is never used
+template <class T>
+void doNotOptimize(const T& value) {
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+class Bench {
+public:
+  struct Stats {
+    std::string phase;
+    size_t iterations{};
+    double median{}; // Nanoseconds
+    double p99{}; // Nanoseconds
+    double allocations{}; // Per iteration
+    double allocatedBytes{}; // Per iteration
+    size_t peakBytes{}; // Highest of any iteration, only with AOC_TRACK_ALLOCS
+    double throughput{}; // Input bytes per second, based on the median
+  };
+
+  Bench(std::string name, size_t inputSize, unsigned warmup, unsigned iterations) : name(std::move(name)), inputSize(inputSize), warmup(warmup), iterations(std::max(iterations, 1u)) {}
+
+  // Runs f repeatedly, only the call itself is timed and destroying its result is not
+  template <class F>
+  void measure(const std::string& phase, F&& f) {
+    for (unsigned i = 0; i < warmup; i++)
+      doNotOptimize(f());
+
+    std::vector<double> samples;
+    Allocations allocated{};
+    size_t peakBytes = 0;
+    for (unsigned i = 0; i < iterations; i++) {
+      AllocRegion region;
+      const auto start = std::chrono::steady_clock::now();
+      const auto result = f();
+      const auto stop = std::chrono::steady_clock::now();
+      const auto used = region.finish();
+      doNotOptimize(result);
+
+      samples.push_back(std::chrono::duration<double, std::nano>(stop - start).count());
+      allocated.count += used.allocated.count;
+      allocated.bytes += used.allocated.bytes;
+      peakBytes = std::max(peakBytes, used.peakBytes);
+    }
+
+    std::ranges::sort(samples);
+    Stats s;
+    s.phase = phase;
+    s.iterations = samples.size();
+    s.median = samples.size() % 2 ? samples[samples.size() / 2] : (samples[samples.size() / 2 - 1] + samples[samples.size() / 2]) / 2;
+    s.p99 = samples[static_cast<size_t>(std::ceil(samples.size() * 0.99)) - 1];
+    s.allocations = static_cast<double>(allocated.count) / samples.size();
+    s.allocatedBytes = static_cast<double>(allocated.bytes) / samples.size();
+    s.peakBytes = peakBytes;
+    s.throughput = s.median > 0 ? inputSize / (s.median * 1e-9) : 0;
+    stats.push_back(s);
+  }
+
+  const std::vector<Stats>& results() const {
+    return stats;
+  }
+
+  // One JSON object per line so runs can be diffed and grepped
+  void printJson(std::ostream& os) const {
+    for (const auto& s : stats) {
+      os << std::fixed << std::setprecision(1)
+         << "{\"name\":\"" << name << "\",\"phase\":\"" << s.phase << "\",\"input_bytes\":" << inputSize
+         << ",\"iterations\":" << s.iterations << ",\"median_ns\":" << s.median << ",\"p99_ns\":" << s.p99
+         << ",\"allocations\":" << s.allocations << ",\"allocated_bytes\":" << s.allocatedBytes;
+      if (TRACK_ALLOCS)
+        os << ",\"peak_bytes\":" << s.peakBytes;
+      os << ",\"bytes_per_second\":" << s.throughput << "}\n";
+    }
+  }
+
+  void printTable(std::ostream& os) const {
+    os << name << " (" << inputSize << " input bytes, " << warmup << " warmup, " << iterations << " iterations)\n";
+    os << std::left << std::setw(12) << "phase" << std::right << std::setw(14) << "median" << std::setw(14) << "p99"
+       << std::setw(14) << "allocs" << std::setw(14) << "alloc bytes";
+    if (TRACK_ALLOCS)
+      os << std::setw(14) << "peak bytes";
+    os << ' ' << std::setw(17) << "throughput" << '\n';
+    for (const auto& s : stats) {
+      os << std::left << std::setw(12) << s.phase << std::right << std::fixed << std::setprecision(0)
+         << std::setw(14) << formatTime(s.median) << std::setw(14) << formatTime(s.p99)
+         << std::setw(14) << s.allocations << std::setw(14) << s.allocatedBytes;
+      if (TRACK_ALLOCS)
+        os << std::setw(14) << s.peakBytes;
+      os << ' ' << std::setw(17) << formatRate(s.throughput) << '\n';
+    }
+  }
+
+private:
+  static std::string formatTime(double ns) {
+    static constexpr std::array<const char*, 4> UNITS{"ns", "us", "ms", "s"};
+    size_t unit = 0;
+    for (; ns >= 1000 && unit < UNITS.size() - 1; unit++)
+      ns /= 1000;
+
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(ns < 10 ? 2 : 1) << ns << ' ' << UNITS[unit];
+    return ss.str();
+  }
+
+  static std::string formatRate(double bytesPerSecond) {
+    static constexpr std::array<const char*, 4> UNITS{"B/s", "KB/s", "MB/s", "GB/s"};
+    size_t unit = 0;
+    for (; bytesPerSecond >= 1000 && unit < UNITS.size() - 1; unit++)
+      bytesPerSecond /= 1000;
+
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(1) << bytesPerSecond << ' ' << UNITS[unit];
+    return ss.str();
+  }
+
+  const std::string name;
+  const size_t inputSize;
+  const unsigned warmup;
+  const unsigned iterations;
+  std::vector<Stats> stats;
+};
+
+}
@@ -0,0 +1,236 @@
+#pragma once
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <optional>
+#include <charconv>
+#include <type_traits>
+#include <utility>
+#include <cassert>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace aoc {
+
+// The whole input in memory. Regular files are memory mapped, anything else
+// (pipes, terminals) is read in one go.
+class Input {
+public:
+  static std::optional<Input> open(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      return {};
+
+    auto input = read(fd);
+    ::close(fd);
+    return input;
+  }
+
+  static std::optional<Input> read(int fd) {
+    Input input;
+
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+      void* mapped = ::mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapped != MAP_FAILED) {
+        ::madvise(mapped, info.st_size, MADV_SEQUENTIAL);
+        input.mapped = static_cast<const char*>(mapped);
+        input.size = info.st_size;
+        return input;
+      }
+    }
+
+    size_t length = 0;
+    input.buffer.resize(1 << 16);
+    while (true) {
+      if (length == input.buffer.size())
+        input.buffer.resize(input.buffer.size() * 2);
+
+      const auto count = ::read(fd, input.buffer.data() + length, input.buffer.size() - length);
+      if (count < 0)
+        return {};
+      if (count == 0)
+        break;
+      length += count;
+    }
+    input.buffer.resize(length);
+
+    return input;
+  }
+
+  Input(Input&& other) noexcept : mapped(other.mapped), size(other.size), buffer(std::move(other.buffer)) {
+    other.mapped = nullptr;
+  }
+
+  Input& operator=(Input&& other) noexcept {
+    std::swap(mapped, other.mapped);
+    std::swap(size, other.size);
+    std::swap(buffer, other.buffer);
+    return *this;
+  }
+
+  ~Input() {
+    if (mapped)
+      ::munmap(const_cast<char*>(mapped), size);
+  }
+
+  std::string_view view() const {
+    return mapped ? std::string_view(mapped, size) : std::string_view(buffer);
+  }
+
+private:
+  Input() = default;
+
+  const char* mapped = nullptr;
+  size_t size = 0;
+  std::string buffer;
+};
+
+// Reads a file as it is written a block at a time, handing every block read
+// to f until f returns false. The blocks are views into a buffer that the next
+// one reuses. False when reading fails.
+template <class F>
+bool readBlocks(int fd, F&& f) {
+  std::string buffer(1 << 16, '\0');
+  ssize_t count;
+  while ((count = ::read(fd, buffer.data(), buffer.size())) > 0)
+    if (!f(std::string_view(buffer.data(), count)))
+      return true;
+  return count == 0;
+}
+
+// Reads a file as it is written, for example a pipe from tail -f, handing
+// every batch of whole lines read at once to f. A last line without a newline
+// comes on its own at the end. The lines are views into a buffer that the
+// next batch reuses. False when reading fails.
+template <class F>
+bool readLines(int fd, F&& f) {
+  std::string buffer(1 << 16, '\0');
+  size_t pending = 0; // Bytes of a line not read to its end yet, at the front
+  ssize_t count;
+  while ((count = ::read(fd, buffer.data() + pending, buffer.size() - pending)) > 0) {
+    const std::string_view block(buffer.data(), pending + count);
+    const auto end = block.rfind('\n');
+    if (end == std::string_view::npos) {
+      pending = block.size();
+      if (pending == buffer.size())
+        buffer.resize(2 * buffer.size());
+      continue;
+    }
+
+    f(block.substr(0, end));
+    pending = block.size() - end - 1;
+    std::copy(block.begin() + end + 1, block.end(), buffer.begin());
+  }
+
+  if (pending > 0)
+    f(std::string_view(buffer.data(), pending));
+  return count == 0;
+}
+
+template <class T>
+T toNumber(std::string_view s) {
+  T result{};
+  [[maybe_unused]] const auto [end, ec] = std::from_chars(s.data(), s.data() + s.size(), result);
+  assert(ec == std::errc{});
+  return result;
+}
+
+// Reads lines, tokens and numbers straight out of the input without copying
+class Scanner {
+public:
+  Scanner(std::string_view data) : data(data) {}
+
+  // Nothing left at all
+  bool empty() const {
+    return pos == data.size();
+  }
+
+  // Nothing left but whitespace
+  bool done() {
+    skipSpace();
+    return empty();
+  }
+
+  char peek() const {
+    return empty() ? '\0' : data[pos];
+  }
+
+  char get() {
+    return empty() ? '\0' : data[pos++];
+  }
+
+  void skip(size_t count) {
+    pos = std::min(pos + count, data.size());
+  }
+
+  void skipSpace() {
+    while (!empty() && isSpace(data[pos]))
+      pos++;
+  }
+
+  // Everything up to the next newline, which is consumed but not included
+  std::string_view line() {
+    const auto end = std::min(data.find('\n', pos), data.size());
+    const auto result = data.substr(pos, end - pos);
+    pos = std::min(end + 1, data.size());
+    return result;
+  }
+
+  // Next run of non-whitespace characters
+  std::string_view token() {
+    skipSpace();
+    const auto start = pos;
+    while (!empty() && !isSpace(data[pos]))
+      pos++;
+    return data.substr(start, pos - start);
+  }
+
+  // Number directly after any whitespace
+  template <class T = int>
+  T number() {
+    skipSpace();
+    T result{};
+    const auto [end, ec] = std::from_chars(data.data() + pos, data.data() + data.size(), result);
+    assert(ec == std::errc{});
+    pos = end - data.data();
+    return result;
+  }
+
+  // Skips whatever precedes the next number, for numbers embedded in text
+  template <class T = int>
+  T nextNumber() {
+    while (!empty() && !startsNumber<T>())
+      pos++;
+    return number<T>();
+  }
+
+  std::string_view rest() const {
+    return data.substr(pos);
+  }
+
+private:
+  static bool isSpace(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+  }
+
+  static bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+  }
+
+  template <class T>
+  bool startsNumber() const {
+    if (isDigit(data[pos]))
+      return true;
+    return std::is_signed_v<T> && data[pos] == '-' && pos + 1 < data.size() && isDigit(data[pos + 1]);
+  }
+
+  std::string_view data;
+  size_t pos = 0;
+};
+
+}
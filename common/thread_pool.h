@@ -0,0 +1,141 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace aoc {
+
+// Work stealing pool: every worker has its own deque of tasks, takes new work
+// from the back of it and steals from the front of the others when it runs
+// dry. Tasks may submit further tasks, which go to the submitting worker.
+class ThreadPool {
+public:
+  using Task = std::function<void()>;
+
+  explicit ThreadPool(unsigned threads = std::thread::hardware_concurrency()) {
+    threads = std::max(threads, 1u);
+    for (unsigned i = 0; i < threads; i++)
+      queues.push_back(std::make_unique<Queue>());
+    for (unsigned i = 0; i < threads; i++)
+      workers.emplace_back([this, i]() { work(i); });
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  ~ThreadPool() {
+    wait();
+    {
+      std::lock_guard lock(mutex);
+      stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers)
+      worker.join();
+  }
+
+  unsigned size() const {
+    return workers.size();
+  }
+
+  void submit(Task task) {
+    const unsigned index = current == this ? currentIndex : next++ % queues.size();
+
+    pending++;
+    {
+      std::lock_guard lock(queues[index]->mutex);
+      queues[index]->tasks.push_back(std::move(task));
+    }
+    {
+      std::lock_guard lock(mutex);
+      queued++;
+    }
+    wake.notify_one();
+  }
+
+  // Blocks until every submitted task, including those submitted by other tasks, is done
+  void wait() {
+    std::unique_lock lock(mutex);
+    idle.wait(lock, [this]() { return pending == 0; });
+  }
+
+private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  bool take(unsigned index, Task& task) {
+    // Own queue first, newest task
+    {
+      auto& own = *queues[index];
+      std::lock_guard lock(own.mutex);
+      if (!own.tasks.empty()) {
+        task = std::move(own.tasks.back());
+        own.tasks.pop_back();
+        return true;
+      }
+    }
+
+    // Steal the oldest task of another worker
+    for (unsigned i = 1; i < queues.size(); i++) {
+      auto& other = *queues[(index + i) % queues.size()];
+      std::lock_guard lock(other.mutex);
+      if (!other.tasks.empty()) {
+        task = std::move(other.tasks.front());
+        other.tasks.pop_front();
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  void work(unsigned index) {
+    current = this;
+    currentIndex = index;
+
+    while (true) {
+      {
+        std::unique_lock lock(mutex);
+        wake.wait(lock, [this]() { return stopping || queued > 0; });
+        if (stopping && queued == 0)
+          return;
+        queued--;
+      }
+
+      // A task is reserved for this worker, although it may sit in another queue
+      Task task;
+      while (!take(index, task))
+        std::this_thread::yield();
+      task();
+
+      if (--pending == 0) {
+        std::lock_guard lock(mutex);
+        idle.notify_all();
+      }
+    }
+  }
+
+  static inline thread_local ThreadPool* current = nullptr;
+  static inline thread_local unsigned currentIndex = 0;
+
+  std::vector<std::unique_ptr<Queue>> queues;
+  std::vector<std::thread> workers;
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable idle;
+  size_t queued = 0; // Tasks not yet reserved by a worker, guarded by mutex
+  std::atomic<size_t> pending{}; // Tasks not yet finished
+  std::atomic<unsigned> next{};
+  bool stopping = false;
+};
+
+}
@@ -3,26 +3,222 @@
 #include <string>
 #include <algorithm>
 #include <numeric>
+#include <functional>
+#include <thread>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
 
-int main() {
-  std::string line;
-  std::vector<unsigned> elves;
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif
+
+#include "../common/aoc.h"
+#include "../common/thread_pool.h"
+
+// Calories carried by the elves carrying the most, in descending order
+using Elves = std::vector<unsigned>;
+
+// The k largest values seen so far, in constant memory
+class Top {
+public:
+  explicit Top(size_t k) : k(std::max<size_t>(k, 1)) {}
+
+  void add(unsigned value) {
+    if (heap.size() < k) {
+      heap.push_back(value);
+      std::ranges::push_heap(heap, std::greater{});
+    } else if (value > heap.front()) {
+      std::ranges::pop_heap(heap, std::greater{});
+      heap.back() = value;
+      std::ranges::push_heap(heap, std::greater{});
+    }
+  }
+
+  void merge(const Top& other) {
+    for (auto value : other.heap)
+      add(value);
+  }
+
+  Elves sorted() const {
+    Elves result = heap;
+    std::ranges::sort(result, std::greater{});
+    return result;
+  }
+
+private:
+  size_t k;
+  std::vector<unsigned> heap; // Min-heap, smallest of the top at the front
+};
+
+// Elves of a part of the input that only holds whole groups, line by line
+Top scanLines(std::string_view input, size_t k) {
+  Top top(k);
+  unsigned calories = 0;
+  bool group = false;
+
+  for (aoc::Scanner scanner(input); !scanner.empty();) {
+    if (const auto line = scanner.line(); line.empty()) {
+      top.add(calories);
+      calories = 0;
+      group = false;
+    } else {
+      calories += aoc::toNumber<unsigned>(line);
+      group = true;
+    }
+  }
+  if (group)
+    top.add(calories);
+
+  return top;
+}
+
+// Bitmaps of the newlines in 64 byte blocks, bit i set when byte i is one
+struct ScalarNewlines {
+  static uint64_t find(const char* block) {
+    uint64_t mask = 0;
+    for (unsigned i = 0; i < 64; i++)
+      mask |= uint64_t{block[i] == '\n'} << i;
+    return mask;
+  }
+};
+
+#ifdef __x86_64__
+struct Sse2Newlines {
+  static uint64_t find(const char* block) {
+    const __m128i newline = _mm_set1_epi8('\n');
+    uint64_t mask = 0;
+    for (unsigned i = 0; i < 4; i++) {
+      const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * i));
+      mask |= uint64_t{static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, newline)))} << (16 * i);
+    }
+    return mask;
+  }
+};
+#endif
+
+// Number of up to 8 digits without branching on its length. The digits are
+// shifted to the top of one word with zeros below, then combined pairwise.
+unsigned parseDigits(const char* digits, size_t length) {
+  uint64_t word;
+  std::memcpy(&word, digits, sizeof(word));
+  word = (word - 0x3030303030303030) << (8 * (8 - length));
+  word = (word & 0x0F0F0F0F0F0F0F0F) * 2561 >> 8;
+  word = (word & 0x00FF00FF00FF00FF) * 6553601 >> 16;
+  return (word & 0x0000FFFF0000FFFF) * 42949672960001 >> 32;
+}
+
+// Same as scanLines, but jumps from newline to newline through the bitmaps of
+// whole blocks and sums the digits of every line straight from the input
+template <class Newlines>
+Top scanBlocks(std::string_view input, size_t k) {
+  Top top(k);
   unsigned calories = 0;
+  bool group = false;
+  size_t start = 0;
 
-  while (std::getline(std::cin, line)) {
-    if (line.empty()) {
-      elves.push_back(calories);
+  const auto line = [&](size_t end) {
+    if (end == start) {
+      top.add(calories);
       calories = 0;
+      group = false;
+    } else if (end - start <= 8 && start + 8 <= input.size()) {
+      calories += parseDigits(input.data() + start, end - start);
+      group = true;
     } else {
-      calories += std::stoi(line);
+      calories += aoc::toNumber<unsigned>(input.substr(start, end - start));
+      group = true;
     }
+    start = end + 1;
+  };
+
+  size_t base = 0;
+  for (; base + 64 <= input.size(); base += 64)
+    for (auto mask = Newlines::find(input.data() + base); mask; mask &= mask - 1)
+      line(base + std::countr_zero(mask));
+
+  // Zero padded last block
+  std::array<char, 64> last{};
+  std::ranges::copy(input.substr(base), last.begin());
+  for (auto mask = Newlines::find(last.data()); mask; mask &= mask - 1)
+    line(base + std::countr_zero(mask));
+
+  if (start < input.size())
+    line(input.size());
+  if (group)
+    top.add(calories);
+
+  return top;
+}
+
+// Flattened so that the bitmaps inline into the loop, built for the instruction set of each
+[[gnu::flatten]] Top scanScalar(std::string_view input, size_t k) {
+  return scanBlocks<ScalarNewlines>(input, k);
+}
+
+#ifdef __x86_64__
+[[gnu::flatten]] Top scanSse2(std::string_view input, size_t k) {
+  return scanBlocks<Sse2Newlines>(input, k);
+}
+#endif
+
+using Scan = Top (*)(std::string_view, size_t);
+
+// Set with --scanner=lines|scalar|sse2, by default sse2 where there is one.
+// That parses about 0.8 GB/s on one thread, against 0.3 GB/s for the other
+// two. The work per line bounds it from there, AVX2 bitmaps were no faster.
+Scan scanner() {
+  const auto name = aoc::options.get("scanner", "");
+  if (name == "lines")
+    return scanLines;
+#ifdef __x86_64__
+  if (name.empty() || name == "sse2")
+    return scanSse2;
+#endif
+  return scanScalar;
+}
+
+// Splits large inputs at blank lines so every group lies within one chunk,
+// then keeps the top of every chunk on its own thread and merges them.
+// The number of elves kept is set with --top=K, part 2 adds them up.
+Elves parse(std::string_view input) {
+  static constexpr size_t MIN_CHUNK = 1 << 20;
+
+  const size_t k = aoc::options.get("top", 3);
+  const auto scan = scanner();
+  const size_t threads = std::min<size_t>(aoc::options.get("threads", std::thread::hardware_concurrency()), input.size() / MIN_CHUNK);
+  if (threads < 2)
+    return scan(input, k).sorted();
+
+  std::vector<size_t> bounds{0};
+  for (size_t i = 1; i < threads; i++) {
+    const auto blank = input.find("\n\n", std::max(bounds.back(), i * input.size() / threads));
+    if (blank == std::string_view::npos)
+      break;
+    bounds.push_back(blank + 2);
   }
-  elves.push_back(calories);
+  bounds.push_back(input.size());
 
-  std::ranges::sort(elves);
+  std::vector<Top> tops(bounds.size() - 1, Top(k));
+  {
+    aoc::ThreadPool pool(tops.size());
+    for (size_t i = 0; i < tops.size(); i++)
+      pool.submit([&, i]() { tops[i] = scan(input.substr(bounds[i], bounds[i + 1] - bounds[i]), k); });
+    pool.wait();
+  }
+
+  for (size_t i = 1; i < tops.size(); i++)
+    tops.front().merge(tops[i]);
+  return tops.front().sorted();
+}
 
-  std::cout << "Part 1 result = " << elves.back() << '\n';
-  std::cout << "Part 2 result = " << std::accumulate(std::prev(elves.end(), 3), elves.end(), 0) << '\n';
+const aoc::Solver solver{
+  .parse = parse,
+  .part1 = [](const Elves& elves) { return elves.empty() ? 0u : elves.front(); },
+  .part2 = [](const Elves& elves) { return std::accumulate(elves.begin(), elves.end(), 0u); },
+};
 
-  return 0;
+int main(int argc, char* argv[]) {
+  return aoc::main(argc, argv, solver);
 }
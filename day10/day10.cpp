@@ -1,115 +1,238 @@
 #include <iostream>
+#include <sstream>
 #include <string>
-#include <set>
 #include <vector>
-#include <memory>
-#include <sstream>
+#include <array>
+#include <algorithm>
+#include <span>
+#include <functional>
+#include <optional>
+#include <cstdint>
 
-class Instruction {
-public:
-  virtual unsigned cycles() = 0;
+#include "../common/aoc.h"
 
-  virtual void run(int& reg) = 0;
+enum Opcode : uint8_t { NOOP, ADDX };
 
-  virtual ~Instruction() {}
+// Cycles taken by every opcode
+constexpr std::array<unsigned, 2> CYCLES{1, 2};
 
+struct Instruction {
+  Opcode opcode{};
+  int32_t operand{}; // 0 for noop
 };
 
-class Add : public Instruction {
-public:
-  Add(int value) : value(value) {}
+using Program = std::vector<Instruction>;
+
+std::optional<Instruction> decode(std::string_view line) {
+  aoc::Scanner scanner(line);
+  if (const auto instr = scanner.token(); instr == "noop")
+    return Instruction{NOOP, 0};
+  else if (instr == "addx")
+    return Instruction{ADDX, scanner.number<int32_t>()};
+  return std::nullopt;
+}
 
-  unsigned cycles() override {
-    return 2;
+aoc::Scanner& operator>>(aoc::Scanner& scanner, Program& program) {
+  while (!scanner.done())
+    if (const auto instruction = decode(scanner.line()))
+      program.push_back(*instruction);
+
+  return scanner;
+}
+
+// Runs instructions a block of cycles at a time, the register value during
+// every cycle going into a trace that is handed on whenever it fills up.
+// Every instruction writes the register for both cycles an instruction may
+// take and moves on by as many as it does, then adds its operand, so the
+// loop never branches on the opcode.
+class Cpu {
+public:
+  template <class F>
+  void run(std::span<const Instruction> instructions, F&& f) {
+    for (const auto& [opcode, operand] : instructions) {
+      if (cycles + 2 > BLOCK)
+        flush(f);
+      trace[cycles] = reg;
+      trace[cycles + 1] = reg;
+      cycles += CYCLES[opcode];
+      reg += operand;
+    }
   }
 
-  void run(int& reg) override {
-    reg += value;
+  // Hands on the cycles run since the last block
+  template <class F>
+  void flush(F&& f) {
+    f(std::span<const int32_t>(trace.data(), cycles));
+    cycles = 0;
   }
 
 private:
-  const int value;
+  static constexpr size_t BLOCK = 1 << 12;
+
+  std::array<int32_t, BLOCK> trace;
+  size_t cycles = 0; // In the trace
+  int32_t reg = 1;
 };
 
-class Noop : public Instruction {
-public:
-  unsigned cycles() override {
-    return 1;
+// Cycles at which the signal strength is sampled, the first and every how
+// many after it
+struct Schedule {
+  size_t first = 20;
+  size_t every = 40;
+};
+
+// Pixels of a frame of the CRT, a bit each, every row in whole words
+struct Frame {
+  size_t width{};
+  size_t height{};
+  size_t pixels{}; // Drawn, fewer than all for a last frame cut short
+  std::vector<uint64_t> bits;
+
+  size_t words() const {
+    return (width + 63) / 64;
   }
 
-  void run([[maybe_unused]] int& reg) override { }
+  bool lit(size_t row, size_t col) const {
+    return bits[row * words() + col / 64] >> (col % 64) & 1;
+  }
 };
 
-using Program = std::vector<std::unique_ptr<Instruction>>;
+// Every row of the frame as far as it is drawn, each on a line of its own
+std::ostream& operator<<(std::ostream& os, const Frame& frame) {
+  for (size_t i = 0; i < frame.pixels; i++) {
+    if (i % frame.width == 0)
+      os << '\n';
+    os << (frame.lit(i / frame.width, i % frame.width) ? '#' : ' ');
+  }
+
+  return os;
+}
 
+// Samples the signal and draws the CRT from the register during every cycle,
+// handing every frame to the sink once it is complete. Without a sink it
+// only samples.
 class Device {
 public:
-  void run(const Program& program) {
-    int reg = 1;
-    unsigned cycle = 1;
-    unsigned measuringCycle = 20;
-
-    strength = 0;
-    CRT.clear();
-
-    for (const auto& instruction : program) {
-      for (unsigned i = 0; i < instruction->cycles(); i++) {
-        // Measuring
-        if (cycle == measuringCycle) {
-          strength += reg * cycle;
-          measuringCycle += WIDTH;
-        }
-
-        // Drawing
-        const int pos = (cycle - 1) % WIDTH;
-        CRT.push_back(pos == reg - 1 || pos == reg || pos == reg + 1 ? '#' : ' ');
-
-        cycle++;
+  using Sink = std::function<void(const Frame&)>;
+
+  Device(size_t width, size_t height, Schedule schedule, Sink sink = {}) : schedule(schedule), next(schedule.first), sink(std::move(sink)) {
+    frame.width = std::max<size_t>(width, 1);
+    frame.height = std::max<size_t>(height, 1);
+    frame.bits.resize(frame.height * frame.words());
+  }
+
+  void draw(std::span<const int32_t> registers) {
+    for (const int64_t reg : registers) {
+      if (++cycle == next) {
+        strength += reg * static_cast<int64_t>(cycle);
+        next += schedule.every;
+      }
+
+      if (!sink)
+        continue;
+
+      if (const int64_t pos = col; pos >= reg - 1 && pos <= reg + 1)
+        frame.bits[row * frame.words() + col / 64] |= uint64_t{1} << (col % 64);
+      frame.pixels++;
+      if (++col == frame.width) {
+        col = 0;
+        if (++row == frame.height)
+          emit();
       }
-      instruction->run(reg);
     }
   }
 
-  int getStrength() const {
+  // Hands on the last frame if cut short
+  void finish() {
+    if (sink && frame.pixels > 0)
+      emit();
+  }
+
+  int64_t signalStrength() const {
     return strength;
   }
 
-  friend std::ostream& operator<<(std::ostream& os, const Device& device);
 private:
-  static constexpr size_t WIDTH = 40;
+  void emit() {
+    sink(frame);
+    std::ranges::fill(frame.bits, 0);
+    frame.pixels = 0;
+    row = 0;
+    col = 0;
+  }
+
+  Schedule schedule;
+  size_t cycle = 0; // Cycles done
+  size_t next; // Cycle of the next sample
+  int64_t strength = 0;
 
-  int strength = 0;
-  std::vector<char> CRT;
+  Sink sink;
+  Frame frame;
+  size_t row = 0;
+  size_t col = 0;
 };
 
-std::ostream& operator<<(std::ostream& os, const Device& device) {
-  for (size_t i = 0; i < device.CRT.size(); i++) {
-    if (i % device.WIDTH == 0)
-      os << '\n';
-    os << device.CRT[i];
-  }
+// Set with --width=N and --height=N for the screen, --first=N and --every=N
+// for the samples
+Device device(Device::Sink sink = {}) {
+  const auto& options = aoc::options;
+  return Device(options.get("width", 40), options.get("height", 6), Schedule{options.get("first", 20), options.get("every", 40)}, std::move(sink));
+}
 
-  return os;
+Device run(const Program& program, Device device) {
+  Cpu cpu;
+  const auto draw = [&device](std::span<const int32_t> registers) { device.draw(registers); };
+  cpu.run(program, draw);
+  cpu.flush(draw);
+  device.finish();
+  return device;
 }
 
-int main() {
-  std::string instr;
-  int value;
-  Device device;
-  Program program;
-
-  while (std::cin >> instr) {
-    if (instr == "noop") {
-      program.push_back(std::make_unique<Noop>());
-    } else if (instr == "addx") {
-      std::cin >> value;
-      program.push_back(std::make_unique<Add>(value));
-    }
-  }
+const aoc::Solver solver{
+  .parse = [](std::string_view input) {
+    Program program;
+    program.reserve(input.size() / 5); // Lines are at least "noop\n"
+    aoc::Scanner scanner(input);
+    scanner >> program;
+    return program;
+  },
+  .part1 = [](const Program& program) { return run(program, device()).signalStrength(); },
+  .part2 = [](const Program& program) {
+    std::ostringstream crt;
+    run(program, device([&crt](const Frame& frame) { crt << frame; }));
+    return crt.str();
+  },
+};
 
-  device.run(program);
-  std::cout << "Part 1 result = " << device.getStrength() << '\n';
-  std::cout << "Part 2 result = " << device << '\n';
+// Usage: day10 --stream [--width=N] [--height=N] [--first=N] [--every=N] [input]
+// Runs the program as it is read, printing every frame after a blank line as
+// soon as it is drawn, and the signal strength at the end. The cycles run go
+// to the screen after every batch of lines read, not only once a block fills.
+int stream() {
+  Cpu cpu;
+  auto screen = device([](const Frame& frame) { std::cout << frame << std::endl; });
+  const auto draw = [&screen](std::span<const int32_t> registers) { screen.draw(registers); };
+  Program block;
+  const bool read = aoc::readInputLines([&](std::string_view lines) {
+    block.clear();
+    aoc::Scanner scanner(lines);
+    scanner >> block;
+    cpu.run(block, draw);
+    cpu.flush(draw);
+  });
+  if (!read)
+    return 1;
 
+  cpu.flush(draw);
+  screen.finish();
+  std::cout << screen.signalStrength() << '\n';
   return 0;
 }
+
+int main(int argc, char* argv[]) {
+  aoc::options = aoc::Options(argc, argv);
+  if (aoc::options.has("stream"))
+    return stream();
+
+  return aoc::main(argc, argv, solver);
+}
@@ -5,6 +5,8 @@
 #include <functional>
 #include <algorithm>
 
+#include "../common/aoc.h"
+
 using Operation = std::function<unsigned(unsigned)>;
 
 class Monkey {
@@ -26,7 +28,7 @@ public:
     return test;
   }
 
-  friend std::istream& operator>>(std::istream& is, Monkey& monkey);
+  friend aoc::Scanner& operator>>(aoc::Scanner& scanner, Monkey& monkey);
 
 private:
   class Item {
@@ -70,65 +72,51 @@ private:
   unsigned inspectionCount{};
 };
 
-std::istream& operator>>(std::istream& is, Monkey& monkey) {
-  const auto skip = [&is](unsigned count) {
-    std::string unused;
-    for (unsigned i = 0; i < count; i++)
-      is >> unused;
-  };
-
-  std::string unused;
-
+aoc::Scanner& operator>>(aoc::Scanner& scanner, Monkey& monkey) {
   // Id
-  is >> unused >> monkey.id >> unused;
+  monkey.id = scanner.nextNumber<unsigned>();
+  scanner.line();
 
   // Items
-  skip(2);
-  while (true) {
-    unsigned item;
-    std::string separator;
-    is >> item >> separator;
-    monkey.items.emplace_back(item);
-    if (separator != ",")
-      break;
-  }
+  aoc::Scanner items(scanner.line());
+  while (!items.done())
+    monkey.items.emplace_back(items.nextNumber<unsigned>());
 
   // Operation
-  const auto operand = [](const std::string& s) -> Operation {
+  const auto operand = [](std::string_view s) -> Operation {
     if (s == "old") {
       return [](unsigned worry) { return worry; };
     } else {
-      unsigned value = std::stoul(s);
+      unsigned value = aoc::toNumber<unsigned>(s);
       return [value]([[maybe_unused]] unsigned worry) { return value; };
     }
   };
 
-  std::string left, right;
-  char op;
-  skip(2);
-  is >> left >> op >> right;
+  aoc::Scanner operation(scanner.line());
+  for (unsigned i = 0; i < 3; i++)
+    operation.token();
+  const auto left = operation.token();
+  const char op = operation.token().front();
+  const auto right = operation.token();
   monkey.operation = [lhs = operand(left), rhs = operand(right), op](unsigned worry) -> unsigned {
     return op == '+' ? lhs(worry) + rhs(worry) : lhs(worry) * rhs(worry);
   };
 
   // Test
-  skip(3);
-  is >> monkey.test;
+  monkey.test = scanner.nextNumber<unsigned>();
 
   // ThrowTrue
-  skip(5);
-  is >> monkey.throwTrue;
+  monkey.throwTrue = scanner.nextNumber<unsigned>();
 
   // ThrowFalse
-  skip(5);
-  is >> monkey.throwFalse;
+  monkey.throwFalse = scanner.nextNumber<unsigned>();
 
-  return is;
+  return scanner;
 }
 
 class Monkeys {
 public:
-  uint64_t turns(unsigned count, bool part1) {
+  uint64_t turns(unsigned count, bool part1) const {
     auto copy = monkeys;
     for (unsigned i = 0; i < count; i++)
       for (auto& monkey : copy)
@@ -142,35 +130,33 @@ public:
     return inspectionCounts[inspectionCounts.size() - 1] * inspectionCounts[inspectionCounts.size() - 2];
   }
   
-  friend std::istream& operator>>(std::istream& is, Monkeys& monkeys);
+  friend aoc::Scanner& operator>>(aoc::Scanner& scanner, Monkeys& monkeys);
 
 private:
   std::vector<Monkey> monkeys;
 };
 
-std::istream& operator>>(std::istream& is, Monkeys& monkeys) {
-  std::string line;
-
-  while (true) {
+aoc::Scanner& operator>>(aoc::Scanner& scanner, Monkeys& monkeys) {
+  while (!scanner.done()) {
     Monkey monkey;
-    std::cin >> monkey;
+    scanner >> monkey;
     monkeys.monkeys.push_back(monkey);
-    while (std::cin.peek() == '\n')
-      std::cin.ignore();
-
-    if (std::cin.eof())
-      break;
   }
 
-  return is;
+  return scanner;
 }
 
-int main() {
-  Monkeys monkeys;
-
-  std::cin >> monkeys;
+const aoc::Solver solver{
+  .parse = [](std::string_view input) {
+    Monkeys monkeys;
+    aoc::Scanner scanner(input);
+    scanner >> monkeys;
+    return monkeys;
+  },
+  .part1 = [](const Monkeys& monkeys) { return monkeys.turns(20, true); },
+  .part2 = [](const Monkeys& monkeys) { return monkeys.turns(10000, false); },
+};
 
-  std::cout << "Part 1 result = " << monkeys.turns(20, true) << '\n';
-  std::cout << "Part 2 result = " << monkeys.turns(10000, false) << '\n';
-  return 0;
+int main(int argc, char* argv[]) {
+  return aoc::main(argc, argv, solver);
 }
@@ -6,6 +6,8 @@
 #include <array>
 #include <limits>
 
+#include "../common/aoc.h"
+
 struct Pos {
   int row{};
   int col{};
@@ -42,7 +44,7 @@ public:
     return fewest;
   }
   
-  friend std::istream& operator>>(std::istream& is, Grid& grid);
+  friend aoc::Scanner& operator>>(aoc::Scanner& scanner, Grid& grid);
 private:
   void reset() {
     for (auto& row : grid)
@@ -82,6 +84,7 @@ private:
 
   std::vector<Tile*> neighbors(const Pos& pos) {
     static constexpr std::array<Pos, 4> OFFSETS{Pos{0, -1}, Pos{0, 1}, Pos{-1, 0}, Pos{1, 0}};
+    AOC_ALLOC_SCOPE("neighbors");
 
     std::vector<Tile*> result;
 
@@ -108,10 +111,9 @@ private:
   Pos end;
 };
 
-std::istream& operator>>(std::istream& is, Grid& grid) {
-  std::string line;
-
-  while (is >> line) {
+aoc::Scanner& operator>>(aoc::Scanner& scanner, Grid& grid) {
+  while (!scanner.done()) {
+    const auto line = scanner.token();
     grid.grid.emplace_back();
     for (size_t col = 0; col < line.size(); col++) {
       char c = line[col];
@@ -127,17 +129,21 @@ std::istream& operator>>(std::istream& is, Grid& grid) {
     }
   }
 
-  return is;
+  return scanner;
 }
 
 
-int main() {
-  Grid grid;
-
-  std::cin >> grid;
-
-  std::cout << "Part 1 result = " << grid.fewestSteps() << '\n';
-  std::cout << "Part 2 result = " << grid.hikingTrail() << '\n';
+const aoc::Solver solver{
+  .parse = [](std::string_view input) {
+    Grid grid;
+    aoc::Scanner scanner(input);
+    scanner >> grid;
+    return grid;
+  },
+  .part1 = [](Grid grid) { return grid.fewestSteps(); },
+  .part2 = [](Grid grid) { return grid.hikingTrail(); },
+};
 
-  return 0;
+int main(int argc, char* argv[]) {
+  return aoc::main(argc, argv, solver);
 }
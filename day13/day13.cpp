@@ -3,6 +3,8 @@
 #include <memory>
 #include <algorithm>
 
+#include "../common/aoc.h"
+
 class List;
 class Value;
 
@@ -75,8 +77,8 @@ private:
   unsigned value;
 };
 
-std::unique_ptr<List> parse(const std::string& line, size_t& i) {
-  const auto parseValue = [](const std::string& line, size_t& i) -> unsigned {
+std::unique_ptr<List> parse(std::string_view line, size_t& i) {
+  const auto parseValue = [](std::string_view line, size_t& i) -> unsigned {
     unsigned result = 0;
     for (char c = line[i]; c != ',' && c != ']'; c = line[++i]) {
       result = result * 10 + (c - '0');
@@ -105,7 +107,7 @@ std::unique_ptr<List> parse(const std::string& line, size_t& i) {
   return list;
 }
 
-std::unique_ptr<List> parse(const std::string& line) {
+std::unique_ptr<List> parse(std::string_view line) {
   size_t i = 1;
   return parse(line, i);
 }
@@ -142,32 +144,35 @@ unsigned part1(const Packets& packets) {
   return result;
 }
 
-unsigned part2(Packets& packets) {
-  packets.push_back(parse("[[2]]"));
-  auto* divider1 = packets.back().get();
-  packets.push_back(parse("[[6]]"));
-  auto* divider2 = packets.back().get();
-
-  std::ranges::sort(packets, [](const auto& p1, const auto& p2) { return *p1 < *p2; });
+unsigned part2(const Packets& packets) {
+  const auto divider1 = parse("[[2]]");
+  const auto divider2 = parse("[[6]]");
 
-  unsigned result = 1;
-  for (size_t i = 0; i < packets.size(); i++)
-    if (auto* ptr = packets[i].get(); ptr == divider1 || ptr == divider2)
-      result *= i + 1;
+  // Positions of the dividers in the sorted packets, without sorting them
+  unsigned index1 = 1 + std::ranges::count_if(packets, [&divider1](const auto& p) { return *p < *divider1; });
+  unsigned index2 = 2 + std::ranges::count_if(packets, [&divider2](const auto& p) { return *p < *divider2; });
 
-  return result;
+  return index1 * index2;
 }
 
-int main() {
-  std::string line;
-  Packets packets;
+aoc::Scanner& operator>>(aoc::Scanner& scanner, Packets& packets) {
+  while (!scanner.done())
+    packets.push_back(parse(scanner.token()));
 
-  while (std::cin >> line) {
-    packets.push_back(parse(line));
-  }
+  return scanner;
+}
 
-  std::cout << "Part 1 result = " << part1(packets) << '\n';
-  std::cout << "Part 2 result = " << part2(packets) << '\n';
+const aoc::Solver solver{
+  .parse = [](std::string_view input) {
+    Packets packets;
+    aoc::Scanner scanner(input);
+    scanner >> packets;
+    return packets;
+  },
+  .part1 = part1,
+  .part2 = part2,
+};
 
-  return 0;
+int main(int argc, char* argv[]) {
+  return aoc::main(argc, argv, solver);
 }
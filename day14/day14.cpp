@@ -5,6 +5,8 @@
 #include <algorithm>
 #include <limits>
 
+#include "../common/aoc.h"
+
 struct Pos {
   int x{};
   int y{};
@@ -56,7 +58,7 @@ unsigned sand(Grid grid, bool part1) {
   return 0;
 }
 
-std::istream& operator>>(std::istream& is, Grid& grid) {
+aoc::Scanner& operator>>(aoc::Scanner& scanner, Grid& grid) {
   const auto createPath = [&grid](const std::vector<Pos>& path) {
     for (size_t i = 1; i < path.size(); i++) {
       const Pos& start = path[i - 1];
@@ -74,36 +76,32 @@ std::istream& operator>>(std::istream& is, Grid& grid) {
     }
   };
 
-  while (!is.eof() && is.peek() != EOF) {
+  while (!scanner.done()) {
     std::vector<Pos> path;
-    std::string unused;
-    char dummy;
-    int x, y;
+    aoc::Scanner line(scanner.line());
 
-    while (true) {
-      is >> x >> dummy >> y;
+    while (!line.done()) {
+      const int x = line.nextNumber();
+      const int y = line.nextNumber();
       path.emplace_back(x, y);
-      if (is.peek() == '\n') {
-        break;
-      } else {
-        is >> unused;
-      }
     }
-    is.ignore();
 
     createPath(path);
-    path.clear();
   }
-  return is;
+  return scanner;
 }
 
-int main() {
-  Grid grid;
-
-  std::cin >> grid;
-
-  std::cout << "Part 1 result = " << sand(grid, true) << '\n';
-  std::cout << "Part 2 result = " << sand(grid, false) << '\n';
+const aoc::Solver solver{
+  .parse = [](std::string_view input) {
+    Grid grid;
+    aoc::Scanner scanner(input);
+    scanner >> grid;
+    return grid;
+  },
+  .part1 = [](const Grid& grid) { return sand(grid, true); },
+  .part2 = [](const Grid& grid) { return sand(grid, false); },
+};
 
-  return 0;
+int main(int argc, char* argv[]) {
+  return aoc::main(argc, argv, solver);
 }
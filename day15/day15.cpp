@@ -5,6 +5,8 @@
 #include <algorithm>
 #include <numeric>
 
+#include "../common/aoc.h"
+
 struct Range {
   int64_t min{}; // Inclusive
   int64_t max{}; // Exclusive
@@ -59,23 +61,18 @@ struct Sensor {
 
 using Grid = std::vector<Sensor>;
 
-std::istream& operator>>(std::istream& is, Grid& grid) {
+aoc::Scanner& operator>>(aoc::Scanner& scanner, Grid& grid) {
   Sensor sensor;
 
-  while (!is.eof() && is.peek() != EOF) {
-    is.ignore(12);
-    is >> sensor.pos.x;
-    is.ignore(4);
-    is >> sensor.pos.y;
-    is.ignore(25);
-    is >> sensor.beacon.x;
-    is.ignore(4);
-    is >> sensor.beacon.y;
-    is.ignore();
+  while (!scanner.done()) {
+    sensor.pos.x = scanner.nextNumber<int64_t>();
+    sensor.pos.y = scanner.nextNumber<int64_t>();
+    sensor.beacon.x = scanner.nextNumber<int64_t>();
+    sensor.beacon.y = scanner.nextNumber<int64_t>();
     grid.push_back(sensor);
   }
 
-  return is;
+  return scanner;
 }
 
 auto findRanges(const Grid& grid, int64_t y) {
@@ -135,13 +132,17 @@ int64_t part2(const Grid& grid, int64_t max) {
   return 0;
 }
 
-int main() {
-  Grid grid;
-
-  std::cin >> grid;
-
-  std::cout << "Part 1 result = " << part1(grid, 2000000) << '\n';
-  std::cout << "Part 2 result = " << part2(grid, 4000000) << '\n';
+const aoc::Solver solver{
+  .parse = [](std::string_view input) {
+    Grid grid;
+    aoc::Scanner scanner(input);
+    scanner >> grid;
+    return grid;
+  },
+  .part1 = [](const Grid& grid) { return part1(grid, 2000000); },
+  .part2 = [](const Grid& grid) { return part2(grid, 4000000); },
+};
 
-  return 0;
+int main(int argc, char* argv[]) {
+  return aoc::main(argc, argv, solver);
 }
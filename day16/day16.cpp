@@ -6,6 +6,8 @@
 #include <string>
 #include <numeric>
 
+#include "../common/aoc.h"
+
 struct Valve {
   unsigned pressure;
   std::map<unsigned, unsigned> connections;
@@ -13,9 +15,7 @@ struct Valve {
 
 using Cave = std::map<unsigned, Valve>;
 
-std::istream& operator>>(std::istream& is, Cave& cave) {
-  std::string unused;
-
+aoc::Scanner& operator>>(aoc::Scanner& scanner, Cave& cave) {
   struct Node {
     std::string name;
     unsigned id;
@@ -24,20 +24,17 @@ std::istream& operator>>(std::istream& is, Cave& cave) {
   };
   std::map<std::string, Node> nodes;
 
-  while (!is.eof() && is.peek() != EOF) {
+  while (!scanner.done()) {
     Node node;
-    is.ignore(5);
-    is >> node.name;
-    is.ignore(15);
-    is >> node.pressure;
-    is >> unused >> unused >> unused >> unused >> unused;
-
-    std::string name;
-    while (is.peek() != '\n' && is.peek() != EOF) {
-      is >> name;
-      node.adjacent.push_back(name.substr(0, 2));
-    }
-    is.ignore();
+    aoc::Scanner line(scanner.line());
+    line.token();
+    node.name = line.token();
+    node.pressure = line.nextNumber<unsigned>();
+    for (unsigned i = 0; i < 5; i++)
+      line.token();
+
+    while (!line.done())
+      node.adjacent.emplace_back(line.token().substr(0, 2));
     nodes[node.name] = node;
   }
 
@@ -77,7 +74,7 @@ std::istream& operator>>(std::istream& is, Cave& cave) {
     cave[node.id].pressure = node.pressure;
   }
 
-  return is;
+  return scanner;
 }
 
 struct Agent {
@@ -103,6 +100,7 @@ void releasePressure(const Cave& cave, std::set<unsigned> opened, Agent you, Age
     opened.insert(elephant.current);
 
   const auto findPaths = [&cave, &opened](const Agent& agent) -> std::map<unsigned, unsigned> {
+    AOC_ALLOC_SCOPE("findPaths");
     if (agent.walking > 0)
       return {{agent.current, agent.walking}};
 
@@ -155,13 +153,17 @@ unsigned part2(const Cave& cave) {
   return best;
 }
 
-int main() {
-  Cave cave;
-
-  std::cin >> cave;
-
-  std::cout << "Part 1 result = " << part1(cave) << '\n';
-  std::cout << "Part 2 result = " << part2(cave) << '\n';
+const aoc::Solver solver{
+  .parse = [](std::string_view input) {
+    Cave cave;
+    aoc::Scanner scanner(input);
+    scanner >> cave;
+    return cave;
+  },
+  .part1 = part1,
+  .part2 = part2,
+};
 
-  return 0;
+int main(int argc, char* argv[]) {
+  return aoc::main(argc, argv, solver);
 }
@@ -6,6 +6,8 @@
 #include <string>
 #include <map>
 
+#include "../common/aoc.h"
+
 struct Pos {
   int64_t x{};
   int64_t y{};
@@ -63,6 +65,7 @@ int64_t fall(const std::string& jet, uint64_t max) {
 
   struct State {
     State(uint64_t index, uint64_t step, uint64_t rock, const Chamber& chamber, int64_t height) : index(index) {
+      AOC_ALLOC_SCOPE("snapshot");
       snapshot = std::to_string(step) + "," + std::to_string(rock) + "\n";
 
       // Assume checking 50 rows is enough
@@ -140,12 +143,12 @@ int64_t fall(const std::string& jet, uint64_t max) {
   return height;
 }
 
-int main() {
-  std::string jet;
-
-  std::cin >> jet;
+const aoc::Solver solver{
+  .parse = [](std::string_view input) { return std::string(aoc::Scanner(input).token()); },
+  .part1 = [](const std::string& jet) { return fall(jet, 2022); },
+  .part2 = [](const std::string& jet) { return fall(jet, 1000000000000); },
+};
 
-  std::cout << "Part 1 result = " << fall(jet, 2022) << '\n';
-  std::cout << "Part 2 result = " << fall(jet, 1000000000000) << '\n';
-  return 0;
+int main(int argc, char* argv[]) {
+  return aoc::main(argc, argv, solver);
 }
@@ -7,6 +7,8 @@
 #include <algorithm>
 #include <numeric>
 
+#include "../common/aoc.h"
+
 struct Pos {
   int x{};
   int y{};
@@ -31,23 +33,26 @@ Pos operator+(Pos left, const Pos& right) {
   return left;
 }
 
-template<>
-struct std::hash<Pos> {
+struct PosHash {
   size_t operator()(const Pos& pos) const {
     return 31 * pos.x + 37 * pos.y + 41 * pos.z;
   }
 };
 
-using Droplet = std::unordered_set<Pos>;
+using Positions = std::unordered_set<Pos, PosHash>;
+using Droplet = Positions;
 
-std::istream& operator>>(std::istream& is, Droplet& droplet) {
+aoc::Scanner& operator>>(aoc::Scanner& scanner, Droplet& droplet) {
   Pos pos;
-  char unused;
 
-  while (is >> pos.x >> unused >> pos.y >> unused >> pos.z)
+  while (!scanner.done()) {
+    pos.x = scanner.nextNumber();
+    pos.y = scanner.nextNumber();
+    pos.z = scanner.nextNumber();
     droplet.insert(pos);
+  }
 
-  return is;
+  return scanner;
 }
 
 unsigned surfaceArea(const Droplet& droplet) {
@@ -68,12 +73,12 @@ unsigned surfaceArea(const Droplet& droplet) {
 unsigned exteriorSurface(const Droplet& droplet) {
   static constexpr std::array<Pos, 6> OFFSETS{Pos{-1, 0, 0}, Pos{1, 0, 0}, Pos{0, -1, 0}, Pos{0, 1, 0}, Pos{0, 0, -1}, Pos{0, 0, 1}};
 
-  const auto findOutside = [&droplet](const Pos& start, unsigned max) -> std::unordered_set<Pos> {
+  const auto findOutside = [&droplet](const Pos& start, unsigned max) -> Positions {
     if (droplet.count(start))
       return {};
 
     std::list<Pos> list{start};
-    std::unordered_set<Pos> visited{start};
+    Positions visited{start};
 
     while (!list.empty()) {
       const auto pos = list.front();
@@ -98,7 +103,7 @@ unsigned exteriorSurface(const Droplet& droplet) {
   unsigned maxVolume = maxSide * maxSide * maxSide;
 
   unsigned count = 0;
-  std::unordered_set<Pos> outside;
+  Positions outside;
 
   for (const auto& pos : droplet) {
     for (const auto& offset : OFFSETS) {
@@ -116,12 +121,17 @@ unsigned exteriorSurface(const Droplet& droplet) {
   return count;
 }
 
-int main() {
-  Droplet droplet;
-
-  std::cin >> droplet;
-  std::cout << "Part 1 result = " << surfaceArea(droplet) << '\n';
-  std::cout << "Part 2 result = " << exteriorSurface(droplet) << '\n';
+const aoc::Solver solver{
+  .parse = [](std::string_view input) {
+    Droplet droplet;
+    aoc::Scanner scanner(input);
+    scanner >> droplet;
+    return droplet;
+  },
+  .part1 = surfaceArea,
+  .part2 = exteriorSurface,
+};
 
-  return 0;
+int main(int argc, char* argv[]) {
+  return aoc::main(argc, argv, solver);
 }
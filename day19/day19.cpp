@@ -6,6 +6,8 @@
 #include <cassert>
 #include <numeric>
 
+#include "../common/aoc.h"
+
 static constexpr size_t RESOURCE_COUNT = 4;
 
 using Robots = std::array<unsigned, RESOURCE_COUNT>;
@@ -13,7 +15,7 @@ using Resources = std::array<unsigned, RESOURCE_COUNT>;
 using Blueprint = std::array<Resources, RESOURCE_COUNT>;
 using Blueprints = std::vector<Blueprint>;
 
-size_t toIndex(const std::string& resource) {
+size_t toIndex(std::string_view resource) {
   if (resource == "ore")
     return 0;
   else if (resource == "clay")
@@ -31,49 +33,58 @@ struct State {
   Resources resources{};
 };
 
-std::istream& operator>>(std::istream& is, Blueprints& blueprints) {
-  const auto skip = [&is](unsigned count) {
-    std::string s;
-    for (unsigned i = 0; i < count; i++) is >> s;
+aoc::Scanner& operator>>(aoc::Scanner& scanner, Blueprints& blueprints) {
+  const auto skip = [&scanner](unsigned count) {
+    for (unsigned i = 0; i < count; i++)
+      scanner.token();
   };
 
-  const auto add = [](Blueprint& blueprint, const std::string& robot, std::string& resource, unsigned cost) {
+  const auto add = [](Blueprint& blueprint, std::string_view robot, std::string_view resource, unsigned cost) {
     if (resource.back() == '.')
-      resource.pop_back();
+      resource.remove_suffix(1);
     blueprint[toIndex(robot)][toIndex(resource)] = cost;
   };
 
-  std::string robot, resource1, resource2, unused;
+  std::string_view robot, resource1, resource2;
   unsigned cost1, cost2;
 
-  while (!is.eof() && is.peek() != EOF) {
+  while (!scanner.done()) {
     Blueprint blueprint{};
     skip(3);
 
     // Ore
-    is >> robot >> unused >> unused >> cost1 >> resource1;
+    robot = scanner.token();
+    skip(2);
+    cost1 = scanner.number<unsigned>();
+    resource1 = scanner.token();
     add(blueprint, robot, resource1, cost1);
 
-
     // Clay
-    is >> unused >> robot >> unused >> unused >> cost1 >> resource1;
+    skip(1);
+    robot = scanner.token();
+    skip(2);
+    cost1 = scanner.number<unsigned>();
+    resource1 = scanner.token();
     add(blueprint, robot, resource1, cost1);
 
-    // Obsidian
-    is >> unused >> robot >> unused >> unused >> cost1 >> resource1 >> unused >> cost2 >> resource2;
-    add(blueprint, robot, resource1, cost1);
-    add(blueprint, robot, resource2, cost2);
-
-    // Geode
-    is >> unused >> robot >> unused >> unused >> cost1 >> resource1 >> unused >> cost2 >> resource2;
-    add(blueprint, robot, resource1, cost1);
-    add(blueprint, robot, resource2, cost2);
+    // Obsidian and geode
+    for (unsigned i = 0; i < 2; i++) {
+      skip(1);
+      robot = scanner.token();
+      skip(2);
+      cost1 = scanner.number<unsigned>();
+      resource1 = scanner.token();
+      skip(1);
+      cost2 = scanner.number<unsigned>();
+      resource2 = scanner.token();
+      add(blueprint, robot, resource1, cost1);
+      add(blueprint, robot, resource2, cost2);
+    }
 
     blueprints.push_back(blueprint);
-    is.ignore();
   }
 
-  return is;
+  return scanner;
 }
 
 void collectGeodes(const Blueprint& blueprint, State state, unsigned time, unsigned& best, const Robots& max) {
@@ -169,13 +180,17 @@ unsigned part2(const Blueprints& blueprints) {
   return std::accumulate(geodes.begin(), geodes.end(), 1, [](const auto& a, const auto& b) { return a * b; });
 }
 
-int main() {
-  Blueprints blueprints;
-
-  std::cin >> blueprints;
-
-  std::cout << "Part 1 result = " << part1(blueprints) << '\n';
-  std::cout << "Part 2 result = " << part2(blueprints) << '\n';
+const aoc::Solver solver{
+  .parse = [](std::string_view input) {
+    Blueprints blueprints;
+    aoc::Scanner scanner(input);
+    scanner >> blueprints;
+    return blueprints;
+  },
+  .part1 = part1,
+  .part2 = part2,
+};
 
-  return 0;
+int main(int argc, char* argv[]) {
+  return aoc::main(argc, argv, solver);
 }
@@ -1,42 +1,203 @@
 #include <iostream>
+#include <vector>
+#include <array>
+#include <numeric>
+#include <thread>
+#include <optional>
+#include <cstdint>
+#include <cstring>
 
-auto calcScore1(unsigned opponent, unsigned you) {
-  unsigned result = you + 1;
+#include "../common/aoc.h"
+#include "../common/thread_pool.h"
 
-  if ((opponent + 1) % 3 == you) {
-    result += 6;
-  } else if (opponent == you) {
-    result += 3;
+// Part 2 encodes the outcome in the second column, in this order
+enum Outcome : unsigned { LOSS, DRAW, WIN };
+
+// Outcome for you, indexed [you][opponent]
+template <unsigned N>
+using Outcomes = std::array<std::array<Outcome, N>, N>;
+
+// Every move beats the moves an odd distance behind it and loses to the rest,
+// for three moves rock, paper and scissors. Only fair for an odd number of
+// moves, with an even one some pairs of moves would both win.
+template <unsigned N>
+constexpr Outcomes<N> cyclic() {
+  static_assert(N % 2 == 1, "cyclic games need an odd number of moves");
+  Outcomes<N> result{};
+  for (unsigned you = 0; you < N; you++) {
+    for (unsigned opponent = 0; opponent < N; opponent++) {
+      const auto distance = (you + N - opponent) % N;
+      result[you][opponent] = distance == 0 ? DRAW : distance % 2 ? WIN : LOSS;
+    }
   }
   return result;
 }
 
-auto calcScore2(unsigned opponent, unsigned outcome) {
-  char you;
-  if (outcome == 0) {
-    you = (opponent + 2) % 3;
-  } else if (outcome == 1) {
-    you = opponent;
-  } else if (outcome == 2) {
-    you = (opponent + 1) % 3;
+// A game of N moves, with the first column the opponent's move from
+// FIRST_OPPONENT on and the second column from FIRST_YOU on. Each move is worth
+// its index plus one, on top of 0, 3 or 6 for the outcome. All scores are
+// tables indexed by the kind of round, opponent * N + second column.
+template <unsigned N, Outcomes<N> OUTCOMES = cyclic<N>(), char FIRST_OPPONENT = 'A', char FIRST_YOU = 'X'>
+struct Game {
+  static constexpr unsigned MOVES = N;
+  static constexpr unsigned KINDS = N * N;
+
+  using Scores = std::array<unsigned, KINDS>;
+  using Tally = std::array<uint64_t, KINDS>;
+
+  static constexpr unsigned score(unsigned opponent, unsigned you) {
+    return you + 1 + 3 * OUTCOMES[you][opponent];
+  }
+
+  // Second column is your move
+  static constexpr Scores SCORES1 = []() {
+    Scores result{};
+    for (unsigned opponent = 0; opponent < N; opponent++)
+      for (unsigned you = 0; you < N; you++)
+        result[opponent * N + you] = score(opponent, you);
+    return result;
+  }();
+
+  // Second column is the outcome, played with the first move giving it
+  static constexpr Scores SCORES2 = []() {
+    Scores result{};
+    for (unsigned opponent = 0; opponent < N; opponent++) {
+      for (unsigned outcome = 0; outcome < std::min(N, 3u); outcome++) {
+        for (unsigned you = 0; you < N; you++) {
+          if (OUTCOMES[you][opponent] == outcome) {
+            result[opponent * N + outcome] = score(opponent, you);
+            break;
+          }
+        }
+      }
+    }
+    return result;
+  }();
+
+  static constexpr unsigned kind(char opponent, char you) {
+    return (opponent - FIRST_OPPONENT) * N + you - FIRST_YOU;
+  }
+
+  static uint64_t total(const Tally& tally, const Scores& scores) {
+    return std::inner_product(tally.begin(), tally.end(), scores.begin(), uint64_t{});
+  }
+};
+
+using RockPaperScissors = Game<3>;
+
+static_assert(RockPaperScissors::SCORES1 == RockPaperScissors::Scores{4, 8, 3, 1, 5, 9, 7, 2, 6});
+static_assert(RockPaperScissors::SCORES2 == RockPaperScissors::Scores{3, 4, 8, 1, 5, 9, 2, 6, 7});
+
+// Five moves, each beating two and losing to two
+static_assert(Game<5>::SCORES1 == Game<5>::Scores{4, 8, 3, 10, 5, 1, 5, 9, 4, 11, 7, 2, 6, 10, 5, 1, 8, 3, 7, 11, 7, 2, 9, 4, 8});
+static_assert(Game<5>::SCORES2 == Game<5>::Scores{3, 4, 8, 0, 0, 1, 5, 9, 0, 0, 2, 6, 7, 0, 0, 1, 7, 8, 0, 0, 2, 8, 7, 0, 0});
+
+// Eight rounds of the form "A X\n" at once
+using Records = uint32_t __attribute__((vector_size(32)));
+
+// Input made of whole records only, the last one possibly without its
+// newline. Built for AVX2 as well as the baseline, picked when the program
+// starts. Nothing when a record turns out otherwise, to fall back on.
+template <class G>
+#ifdef __x86_64__
+[[gnu::target_clones("avx2", "default")]]
+#endif
+std::optional<typename G::Tally> tallyRecords(std::string_view input) {
+  static constexpr Records ONE{1, 1, 1, 1, 1, 1, 1, 1};
+  static constexpr Records ZERO{};
+  static constexpr uint32_t SEPARATORS = ' ' << 8 | '\n' << 24;
+
+  std::array<Records, G::KINDS> counts{};
+  Records malformed{};
+  const size_t blocks = input.size() / sizeof(Records);
+  for (size_t i = 0; i < blocks; i++) {
+    Records records;
+    std::memcpy(&records, input.data() + i * sizeof(Records), sizeof(Records));
+    const Records kinds = G::kind(0, 0) + (records & 0xFF) * G::MOVES + (records >> 16 & 0xFF);
+    malformed |= (Records)((records & 0xFF00FF00) != SEPARATORS) | (Records)(kinds >= G::KINDS);
+    for (unsigned kind = 0; kind < counts.size(); kind++)
+      counts[kind] += kinds == kind ? ONE : ZERO;
   }
+  for (unsigned lane = 0; lane < 8; lane++)
+    if (malformed[lane])
+      return std::nullopt;
+
+  typename G::Tally tally{};
+  for (unsigned kind = 0; kind < counts.size(); kind++)
+    for (unsigned lane = 0; lane < 8; lane++)
+      tally[kind] += counts[kind][lane];
+
+  for (size_t i = blocks * sizeof(Records); i < input.size(); i += 4) {
+    const auto record = input.substr(i, 4);
+    if (record.size() < 3 || record[1] != ' ' || (record.size() == 4 && record[3] != '\n'))
+      return std::nullopt;
+    const auto kind = G::kind(record[0], record[2]);
+    if (kind >= G::KINDS)
+      return std::nullopt;
+    tally[kind]++;
+  }
+
+  return tally;
+}
 
-  return calcScore1(opponent, you);
+// Any other layout, round by round
+template <class G>
+typename G::Tally tallyTokens(std::string_view input) {
+  typename G::Tally tally{};
+  aoc::Scanner scanner(input);
+  while (!scanner.done()) {
+    const auto opponent = scanner.token();
+    const auto you = scanner.token();
+    if (you.empty())
+      break;
+    if (const auto kind = G::kind(opponent.front(), you.front()); kind < G::KINDS)
+      tally[kind]++;
+  }
+  return tally;
 }
 
-int main() {
-  char opponent, you;
+// Large inputs of whole records are split across --threads=N threads. Inputs
+// with any other layout are read by token instead.
+template <class G>
+typename G::Tally parse(std::string_view input) {
+  static constexpr size_t MIN_CHUNK = 1 << 20;
 
-  unsigned part1 = 0;
-  unsigned part2 = 0;
+  input = input.substr(0, input.find_last_not_of(" \n\r\t") + 1);
+  const bool records = input.size() % 4 == 3 && input[1] == ' ';
+  if (!records)
+    return tallyTokens<G>(input);
+
+  const size_t threads = std::min<size_t>(aoc::options.get("threads", std::thread::hardware_concurrency()), input.size() / MIN_CHUNK);
+  if (threads < 2) {
+    const auto tally = tallyRecords<G>(input);
+    return tally ? *tally : tallyTokens<G>(input);
+  }
 
-  while (std::cin >> opponent >> you) {
-    part1 += calcScore1(opponent - 'A', you - 'X'); 
-    part2 += calcScore2(opponent - 'A', you - 'X');
+  std::vector<std::optional<typename G::Tally>> tallies(threads);
+  {
+    aoc::ThreadPool pool(threads);
+    const size_t chunk = input.size() / threads / 4 * 4;
+    for (size_t i = 0; i < threads; i++)
+      pool.submit([&, i]() { tallies[i] = tallyRecords<G>(input.substr(i * chunk, i + 1 < threads ? chunk : std::string_view::npos)); });
+    pool.wait();
   }
 
-  std::cout << "Part 1 result = " << part1 << '\n';
-  std::cout << "Part 2 result = " << part2 << '\n';
+  typename G::Tally tally{};
+  for (const auto& t : tallies) {
+    if (!t)
+      return tallyTokens<G>(input);
+    for (unsigned kind = 0; kind < tally.size(); kind++)
+      tally[kind] += (*t)[kind];
+  }
+  return tally;
+}
+
+const aoc::Solver solver{
+  .parse = parse<RockPaperScissors>,
+  .part1 = [](const RockPaperScissors::Tally& tally) { return RockPaperScissors::total(tally, RockPaperScissors::SCORES1); },
+  .part2 = [](const RockPaperScissors::Tally& tally) { return RockPaperScissors::total(tally, RockPaperScissors::SCORES2); },
+};
 
-  return 0;
+int main(int argc, char* argv[]) {
+  return aoc::main(argc, argv, solver);
 }
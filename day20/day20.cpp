@@ -3,6 +3,8 @@
 #include <list>
 #include <iterator>
 
+#include "../common/aoc.h"
+
 struct Coordinate {
   int64_t value{};
   unsigned id{};
@@ -11,12 +13,11 @@ struct Coordinate {
 
 using File = std::list<Coordinate>;
 
-std::istream& operator>>(std::istream& is, File& file) {
-  int64_t value;
+aoc::Scanner& operator>>(aoc::Scanner& scanner, File& file) {
   unsigned id = 0;
-  while (is >> value)
-    file.emplace_back(value, id++, false);
-  return is;
+  while (!scanner.done())
+    file.emplace_back(scanner.number<int64_t>(), id++, false);
+  return scanner;
 }
 
 int64_t mix(File file, unsigned rounds = 1, int64_t mul = 1) {
@@ -79,12 +80,17 @@ int64_t mix(File file, unsigned rounds = 1, int64_t mul = 1) {
   return result;
 }
 
-int main() {
-  File file;
-  std::cin >> file;
-
-  std::cout << "Part 1 result = " << mix(file) << '\n';
-  std::cout << "Part 2 result = " << mix(file, 10, 811589153) << '\n';
+const aoc::Solver solver{
+  .parse = [](std::string_view input) {
+    File file;
+    aoc::Scanner scanner(input);
+    scanner >> file;
+    return file;
+  },
+  .part1 = [](const File& file) { return mix(file); },
+  .part2 = [](const File& file) { return mix(file, 10, 811589153); },
+};
 
-  return 0;
+int main(int argc, char* argv[]) {
+  return aoc::main(argc, argv, solver);
 }
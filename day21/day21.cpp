@@ -1,12 +1,12 @@
 #include <iostream>
 #include <map>
 #include <vector>
-#include <sstream>
 #include <string>
 #include <optional>
-#include <iterator>
 #include <cassert>
 
+#include "../common/aoc.h"
+
 class Monkey;
 
 using Monkeys = std::map<std::string, Monkey>;
@@ -73,7 +73,7 @@ private:
     if (name == "humn")
       return true;
 
-    if (*value)
+    if (value)
       return false;
 
     return monkeys.at(lhs).hasHuman(monkeys) || monkeys.at(rhs).hasHuman(monkeys);
@@ -87,36 +87,34 @@ private:
 };
 
 
-std::istream& operator>>(std::istream& is, Monkeys& monkeys) {
-  const auto split = [](const std::string& s) -> std::vector<std::string> {
-    std::vector<std::string> result;
-    std::istringstream ss(s);
-    std::copy(std::istream_iterator<std::string>(ss), std::istream_iterator<std::string>(), std::back_inserter(result));
-    return result;
-  };
-
-  std::string line;
-
-  while (std::getline(is, line)) {
-    auto words = split(line);
-    auto name = words[0].substr(0, words[0].size() - 1);
-    if (words.size() == 2) {
-      monkeys.emplace(name, Monkey{name, std::stoi(words[1])});
+aoc::Scanner& operator>>(aoc::Scanner& scanner, Monkeys& monkeys) {
+  while (!scanner.done()) {
+    aoc::Scanner line(scanner.line());
+    const auto first = line.token();
+    const auto name = std::string(first.substr(0, first.size() - 1));
+    const auto second = line.token();
+    if (line.done()) {
+      monkeys.emplace(name, Monkey{name, aoc::toNumber<int64_t>(second)});
     } else {
-      monkeys.emplace(name, Monkey{name, words[1], words[3], words[2][0]});
+      const char op = line.token().front();
+      monkeys.emplace(name, Monkey{name, std::string(second), std::string(line.token()), op});
     }
   }
 
-  return is;
+  return scanner;
 }
 
-int main() {
-  Monkeys monkeys;
-
-  std::cin >> monkeys;
-
-  std::cout << "Part 1 result = " << monkeys.at("root").evaluate(monkeys) << '\n';
-  std::cout << "Part 2 result = " << monkeys.at("root").human(monkeys) << '\n';
+const aoc::Solver solver{
+  .parse = [](std::string_view input) {
+    Monkeys monkeys;
+    aoc::Scanner scanner(input);
+    scanner >> monkeys;
+    return monkeys;
+  },
+  .part1 = [](const Monkeys& monkeys) { return monkeys.at("root").evaluate(monkeys); },
+  .part2 = [](const Monkeys& monkeys) { return monkeys.at("root").human(monkeys); },
+};
 
-  return 0;
+int main(int argc, char* argv[]) {
+  return aoc::main(argc, argv, solver);
 }
@@ -6,6 +6,8 @@
 #include <memory>
 #include <cmath>
 
+#include "../common/aoc.h"
+
 struct Pos {
   int row{};
   int col{};
@@ -188,10 +190,11 @@ private:
 
 class Board {
 public:
-  unsigned run(bool part1) {
+  unsigned run(bool part1) const {
     Flat flat{positions};
     Cube cube{positions};
 
+    Player player = this->player;
     player.reset();
     for (const auto& instr : instructions)
       if (part1)
@@ -202,7 +205,7 @@ public:
     return 1000 * (player.pos.row + 1) + 4 * (player.pos.col + 1) + player.dir;
   }
 
-  friend std::istream& operator>>(std::istream& is, Board& board);
+  friend aoc::Scanner& operator>>(aoc::Scanner& scanner, Board& board);
 
 private:
   Positions positions;
@@ -210,13 +213,12 @@ private:
   std::vector<std::unique_ptr<Instr>> instructions;
 };
 
-std::istream& operator>>(std::istream& is, Board& board) {
-  std::string line;
-
+aoc::Scanner& operator>>(aoc::Scanner& scanner, Board& board) {
   unsigned row = 0;
   int startCol = -1;
-  while (std::getline(is, line)) {
-    if (!(line.front() == ' ' || line.front() == '.' || line.front() == '#'))
+  while (!scanner.empty()) {
+    const auto line = scanner.line();
+    if (line.empty() || !(line.front() == ' ' || line.front() == '.' || line.front() == '#'))
       break;
 
     for (unsigned col = 0; col < line.size(); col++) {
@@ -232,32 +234,28 @@ std::istream& operator>>(std::istream& is, Board& board) {
 
   board.player.start = {0, startCol};
 
-  unsigned steps;
-  char dir;
-  while (true) {
-    if (is >> steps) {
-      board.instructions.push_back(std::make_unique<MoveInstr>(steps));
-    } else {
-      break;
-    }
+  while (!scanner.done()) {
+    board.instructions.push_back(std::make_unique<MoveInstr>(scanner.number<unsigned>()));
 
-    if (is >> dir) {
-      board.instructions.push_back(std::make_unique<RotInstr>(dir));
-    } else {
+    if (scanner.done())
       break;
-    }
+    board.instructions.push_back(std::make_unique<RotInstr>(scanner.get()));
   }
 
-  return is;
+  return scanner;
 }
 
-int main() {
-  Board board;
-
-  std::cin >> board;
-
-  std::cout << "Part 1 result = " << board.run(true) << '\n';
-  std::cout << "Part 2 result = " << board.run(false) << '\n';
+const aoc::Solver solver{
+  .parse = [](std::string_view input) {
+    Board board;
+    aoc::Scanner scanner(input);
+    scanner >> board;
+    return board;
+  },
+  .part1 = [](const Board& board) { return board.run(true); },
+  .part2 = [](const Board& board) { return board.run(false); },
+};
 
-  return 0;
+int main(int argc, char* argv[]) {
+  return aoc::main(argc, argv, solver);
 }
@@ -5,6 +5,8 @@
 #include <string>
 #include <algorithm>
 
+#include "../common/aoc.h"
+
 struct Pos {
   int64_t x{};
   int64_t y{};
@@ -25,11 +27,11 @@ Pos operator+(Pos left, const Pos& right) {
 
 using Grid = std::set<Pos>;
 
-std::istream& operator>>(std::istream& is, Grid& grid) {
-  std::string line;
+aoc::Scanner& operator>>(aoc::Scanner& scanner, Grid& grid) {
   unsigned y = 0;
 
-  while (is >> line) {
+  while (!scanner.done()) {
+    const auto line = scanner.token();
     for (unsigned x = 0; x < line.size(); x++) {
       if (line[x] == '#') {
         grid.insert(Pos(x, y));
@@ -37,7 +39,7 @@ std::istream& operator>>(std::istream& is, Grid& grid) {
     }
     y++;
   }
-  return is;
+  return scanner;
 }
 
 unsigned spread(Grid grid, bool part1) {
@@ -78,6 +80,7 @@ unsigned spread(Grid grid, bool part1) {
   };
 
   for (unsigned round = 0; part1 ? round < 10 : true; round++) {
+    AOC_ALLOC_SCOPE("round");
     std::map<Pos, unsigned> moveCounts;
     std::map<Pos, Pos> moves;
 
@@ -125,13 +128,17 @@ unsigned spread(Grid grid, bool part1) {
   return rectangle();
 }
 
-int main() {
-  Grid grid;
-
-  std::cin >> grid;
-
-  std::cout << "Part 1 result = " << spread(grid, true) << '\n';
-  std::cout << "Part 2 result = " << spread(grid, false) << '\n';
+const aoc::Solver solver{
+  .parse = [](std::string_view input) {
+    Grid grid;
+    aoc::Scanner scanner(input);
+    scanner >> grid;
+    return grid;
+  },
+  .part1 = [](const Grid& grid) { return spread(grid, true); },
+  .part2 = [](const Grid& grid) { return spread(grid, false); },
+};
 
-  return 0;
+int main(int argc, char* argv[]) {
+  return aoc::main(argc, argv, solver);
 }
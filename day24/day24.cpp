@@ -1,11 +1,14 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <array>
 #include <set>
 #include <list>
 #include <map>
 #include <cassert>
 
+#include "../common/aoc.h"
+
 struct Pos {
   int64_t row{};
   int64_t col{};
@@ -50,7 +53,8 @@ using Tiles = std::vector<std::vector<Tile>>;
 
 class Grid {
 public:
-  std::pair<unsigned, unsigned> path() const {
+  // Time to make the given number of trips back and forth between start and end
+  unsigned path(unsigned trips) const {
     static constexpr std::array<Pos, 5> OFFSETS{Pos{0, 0}, Pos{-1, 0}, Pos{1, 0}, Pos{0, -1}, Pos{0, 1}};
 
     // A node occupies a (row, col, time) position
@@ -71,6 +75,7 @@ public:
     std::vector<Tiles> grids{grid};
     Tiles current = grid;
     Tiles next = current;
+    unsigned period = 0;
     for (unsigned time = 0;; time++) {
       // Clear next
       for (auto& row : next)
@@ -110,15 +115,19 @@ public:
 
       current = next;
 
-      if (repeated)
+      if (repeated) {
+        period = time + 1;
         break;
+      }
     }
 
-    const auto BFS = [&graph](const Pos3& start, const Pos& end) -> unsigned {
-      std::list<Node*> list{&graph[start]};
+    // Start time is absolute, while the graph only covers one blizzard period
+    const auto BFS = [&graph, period](const Pos3& start, const Pos& end) -> unsigned {
+      auto& first = graph[{start.pos, start.time % period}];
+      std::list<Node*> list{&first};
       
       // Reset
-      graph[start].value = start.time;
+      first.value = start.time;
       for (auto& [pos, node] : graph)
         node.visited = false;
 
@@ -143,13 +152,15 @@ public:
       assert(false);
     };
 
-    auto time1 = BFS({start.row, start.col, 0}, end);
-    auto time2 = BFS({end.row, end.col, time1}, start);
-    auto time3 = BFS({start.row, start.col, time2}, end);
-    return {time1, time3};
+    unsigned time = 0;
+    for (unsigned trip = 0; trip < trips; trip++) {
+      const auto& [from, to] = trip % 2 ? std::pair{end, start} : std::pair{start, end};
+      time = BFS({from.row, from.col, time}, to);
+    }
+    return time;
   }
 
-friend std::istream& operator>>(std::istream& is, Grid& grid);
+friend aoc::Scanner& operator>>(aoc::Scanner& scanner, Grid& grid);
 
 private:
   Tiles grid;
@@ -157,12 +168,11 @@ private:
   Pos end;
 };
 
-std::istream& operator>>(std::istream& is, Grid& grid) {
+aoc::Scanner& operator>>(aoc::Scanner& scanner, Grid& grid) {
   static const std::map<char, Pos> BLIZZARDS{{'>', Pos{0, 1}}, {'v', Pos{1, 0}}, {'<', Pos{0, -1}}, {'^', Pos{-1, 0}}};
 
-  std::string line;
-
-  while (is >> line) {
+  while (!scanner.done()) {
+    const auto line = scanner.token();
     grid.grid.emplace_back();
     for (unsigned col = 0; col < line.size(); col++) {
       if (line[col] == '#') {
@@ -184,17 +194,20 @@ std::istream& operator>>(std::istream& is, Grid& grid) {
     }
   }
 
-  return is;
+  return scanner;
 }
 
-int main() {
-  Grid grid;
-
-  std::cin >> grid;
-
-  const auto [part1, part2] = grid.path();
-  std::cout << "Part 1 result = " << part1 << '\n';
-  std::cout << "Part 2 result = " << part2 << '\n';
+const aoc::Solver solver{
+  .parse = [](std::string_view input) {
+    Grid grid;
+    aoc::Scanner scanner(input);
+    scanner >> grid;
+    return grid;
+  },
+  .part1 = [](const Grid& grid) { return grid.path(1); },
+  .part2 = [](const Grid& grid) { return grid.path(3); },
+};
 
-  return 0;
+int main(int argc, char* argv[]) {
+  return aoc::main(argc, argv, solver);
 }
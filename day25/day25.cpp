@@ -5,6 +5,8 @@
 #include <cassert>
 #include <numeric>
 
+#include "../common/aoc.h"
+
 constexpr std::array<char, 5> DIGITS{'=', '-', '0', '1', '2'};
 
 char toDigit(int i) {
@@ -67,21 +69,23 @@ std::string addSNAFU(std::string s1, std::string s2) {
 
 using Numbers = std::vector<std::string>;
 
-std::istream& operator>>(std::istream& is, Numbers& numbers) {
-  std::string line;
-
-  while (is >> line)
-    numbers.push_back(line);
+aoc::Scanner& operator>>(aoc::Scanner& scanner, Numbers& numbers) {
+  while (!scanner.done())
+    numbers.emplace_back(scanner.token());
 
-  return is;
+  return scanner;
 }
 
-int main() {
-  Numbers numbers;
-
-  std::cin >> numbers;
-
-  std::cout << "Part 1 result = " << std::accumulate(numbers.begin(), numbers.end(), std::string{"0"}, [](const auto& a, const auto& b) { return addSNAFU(a, b); }) << '\n';
-
-  return 0;
+const aoc::Solver solver{
+  .parse = [](std::string_view input) {
+    Numbers numbers;
+    aoc::Scanner scanner(input);
+    scanner >> numbers;
+    return numbers;
+  },
+  .part1 = [](const Numbers& numbers) { return std::accumulate(numbers.begin(), numbers.end(), std::string{"0"}, [](const auto& a, const auto& b) { return addSNAFU(a, b); }); },
+};
+
+int main(int argc, char* argv[]) {
+  return aoc::main(argc, argv, solver);
 }
@@ -1,60 +1,86 @@
 #include <iostream>
 #include <string>
-#include <algorithm>
+#include <vector>
+#include <array>
+#include <bit>
+#include <cstdint>
 
-using Rucksacks = std::vector<std::string>;
+#include "../common/aoc.h"
 
-unsigned priority(char c) {
-  return c < 'a' ? c - 'A' + 27 : c - 'a' + 1;
-}
+// Set of item types, bit i set for the item of priority i
+using Items = uint64_t;
 
-unsigned part1(const Rucksacks& rucksacks) {
-  unsigned result = 0;
+struct Rucksack {
+  Items first{};
+  Items second{};
+};
 
-  for (std::string rucksack : rucksacks) {
-    const auto middle = std::next(rucksack.begin(), rucksack.size() / 2);
-    std::sort(rucksack.begin(), middle);
-    std::sort(middle, rucksack.end());
+using Rucksacks = std::vector<Rucksack>;
 
-    std::string shared;
-    std::set_intersection(rucksack.begin(), middle, middle, rucksack.end(), std::back_inserter(shared));
-    result += priority(shared.front());
-  }
+constexpr std::array<uint8_t, 256> PRIORITIES = []() {
+  std::array<uint8_t, 256> result{};
+  for (char c = 'a'; c <= 'z'; c++)
+    result[c] = c - 'a' + 1;
+  for (char c = 'A'; c <= 'Z'; c++)
+    result[c] = c - 'A' + 27;
+  return result;
+}();
 
+Items items(std::string_view contents) {
+  Items result = 0;
+  for (unsigned char c : contents)
+    result |= Items{1} << PRIORITIES[c];
   return result;
 }
 
+// Priority of the only item in the set
+unsigned priority(Items items) {
+  return std::countr_zero(items);
+}
 
+unsigned part1(const Rucksacks& rucksacks) {
+  unsigned result = 0;
+  for (const auto& rucksack : rucksacks)
+    result += priority(rucksack.first & rucksack.second);
+  return result;
+}
+
+// Elves per group are set with --group=N, default 3. A last group with fewer
+// elves than that is left out.
 unsigned part2(const Rucksacks& rucksacks) {
-  static constexpr unsigned GROUP_SIZE = 3;
+  const size_t groupSize = std::max(aoc::options.get("group", 3), 1u);
 
   unsigned result = 0;
-
-  for (auto itr = rucksacks.begin(); itr != rucksacks.end(); itr++) {
-    std::string shared = *itr;
-    std::sort(shared.begin(), shared.end());
-    for (unsigned i = 0; i < GROUP_SIZE - 1; i++) {
-      std::string rucksack = *(++itr);
-      std::sort(rucksack.begin(), rucksack.end());
-      std::string intersection;
-      std::set_intersection(shared.begin(), shared.end(), rucksack.begin(), rucksack.end(), std::back_inserter(intersection));
-      shared = std::move(intersection);
-    }
-    result += priority(shared.front());
+  for (size_t group = 0; group + groupSize <= rucksacks.size(); group += groupSize) {
+    Items shared = ~Items{};
+    for (size_t i = group; i < group + groupSize; i++)
+      shared &= rucksacks[i].first | rucksacks[i].second;
+    result += priority(shared);
   }
-
   return result;
 }
 
-int main() {
-  std::string line;
-  Rucksacks rucksacks;
+aoc::Scanner& operator>>(aoc::Scanner& scanner, Rucksacks& rucksacks) {
+  while (!scanner.done()) {
+    const auto contents = scanner.token();
+    const auto middle = contents.size() / 2;
+    rucksacks.emplace_back(items(contents.substr(0, middle)), items(contents.substr(middle)));
+  }
 
-  while (std::cin >> line)
-    rucksacks.push_back(line);
+  return scanner;
+}
 
-  std::cout << "Part 1 result = " << part1(rucksacks) << '\n';
-  std::cout << "Part 2 result = " << part2(rucksacks) << '\n';
+const aoc::Solver solver{
+  .parse = [](std::string_view input) {
+    Rucksacks rucksacks;
+    aoc::Scanner scanner(input);
+    scanner >> rucksacks;
+    return rucksacks;
+  },
+  .part1 = part1,
+  .part2 = part2,
+};
 
-  return 0;
+int main(int argc, char* argv[]) {
+  return aoc::main(argc, argv, solver);
 }
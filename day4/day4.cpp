@@ -1,21 +1,192 @@
 #include <iostream>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <span>
+#include <cstdint>
+#include <cstring>
 
-int main() {
-  unsigned min1, max1, min2, max2;
-  char unused;
+#include "../common/aoc.h"
 
-  unsigned part1 = 0;
-  unsigned part2 = 0;
+// Bounds of both ranges of every pair, one array per bound so that the
+// predicates of the parts run over whole vectors
+struct Assignments {
+  std::vector<uint16_t> min1;
+  std::vector<uint16_t> max1;
+  std::vector<uint16_t> min2;
+  std::vector<uint16_t> max2;
 
-  while (std::cin >> min1 >> unused >> max1 >> unused >> min2 >> unused >> max2) {
-    if ((min1 >= min2 && max1 <= max2) || (min2 >= min1 && max2 <= max1))
-      part1++;
-    if ((max1 >= min2 && min1 <= max2) || (max2 >= min1 && min2 <= max1))
-      part2++;
+  size_t size() const {
+    return min1.size();
   }
+};
 
-  std::cout << "Part 1 result = " << part1 << '\n';
-  std::cout << "Part 2 result = " << part2 << '\n';
+aoc::Scanner& operator>>(aoc::Scanner& scanner, Assignments& assignments) {
+  while (!scanner.done()) {
+    assignments.min1.push_back(scanner.nextNumber<uint16_t>());
+    assignments.max1.push_back(scanner.nextNumber<uint16_t>());
+    assignments.min2.push_back(scanner.nextNumber<uint16_t>());
+    assignments.max2.push_back(scanner.nextNumber<uint16_t>());
+  }
+
+  return scanner;
+}
+
+struct Contains {
+  template <class T>
+  static auto test(T min1, T max1, T min2, T max2) {
+    return (min1 >= min2 && max1 <= max2) || (min2 >= min1 && max2 <= max1);
+  }
+};
+
+struct Overlaps {
+  template <class T>
+  static auto test(T min1, T max1, T min2, T max2) {
+    return (max1 >= min2 && min1 <= max2) || (max2 >= min1 && min2 <= max1);
+  }
+};
+
+// Eight pairs at once
+using Lanes = uint16_t __attribute__((vector_size(16)));
+using Mask = int16_t __attribute__((vector_size(16)));
+
+// Pairs for which the predicate holds, tested a vector of pairs at a time with
+// the lane masks (-1 where true) summed into 16 bit counters that are emptied
+// before they can overflow. Memory bound already with SSE2 sized vectors.
+template <class Predicate>
+unsigned count(const Assignments& assignments) {
+  static constexpr size_t LANES = sizeof(Lanes) / sizeof(uint16_t);
+  static constexpr size_t FLUSH = 1 << 15;
+
+  const auto load = [](const std::vector<uint16_t>& bounds, size_t i) {
+    Lanes lanes;
+    std::memcpy(&lanes, bounds.data() + i, sizeof(lanes));
+    return lanes;
+  };
+
+  unsigned result = 0;
+  size_t i = 0;
+  while (i + LANES <= assignments.size()) {
+    Mask counts{};
+    for (size_t block = 0; block < FLUSH && i + LANES <= assignments.size(); block++, i += LANES)
+      counts += Predicate::test(load(assignments.min1, i), load(assignments.max1, i), load(assignments.min2, i), load(assignments.max2, i));
+    for (size_t lane = 0; lane < LANES; lane++)
+      result -= counts[lane];
+  }
+
+  for (; i < assignments.size(); i++)
+    result += Predicate::test(assignments.min1[i], assignments.max1[i], assignments.min2[i], assignments.max2[i]);
+
+  return result;
+}
+
+struct Range {
+  uint16_t min{};
+  uint16_t max{};
+};
+
+// Every range of every pair, for counting how many contain or overlap a
+// given range in O(log n) per query
+class RangeIndex {
+public:
+  explicit RangeIndex(const Assignments& assignments) {
+    for (size_t i = 0; i < assignments.size(); i++) {
+      ranges.emplace_back(assignments.min1[i], assignments.max1[i]);
+      ranges.emplace_back(assignments.min2[i], assignments.max2[i]);
+    }
+    std::ranges::sort(ranges, {}, &Range::min);
+
+    for (const auto& range : ranges) {
+      mins.push_back(range.min);
+      maxs.push_back(range.max);
+    }
+    std::ranges::sort(maxs);
+  }
+
+  // Ranges sharing at least one section with the query: all but those ending
+  // before it and those starting after it
+  size_t overlapping(const Range& query) const {
+    const auto endingBefore = std::ranges::lower_bound(maxs, query.min) - maxs.begin();
+    const auto startingAfter = mins.end() - std::ranges::upper_bound(mins, query.max);
+    return ranges.size() - endingBefore - startingAfter;
+  }
+
+  // Ranges with every section of the query, for a batch of queries at once.
+  // Sweeps the queries by their start while adding the ranges starting no
+  // later to a Fenwick tree over the range ends, then counts the ends reaching
+  // the end of the query.
+  std::vector<size_t> containing(std::span<const Range> queries) const {
+    std::vector<size_t> order(queries.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::sort(order, {}, [&queries](size_t i) { return queries[i].min; });
+
+    std::vector<size_t> result(queries.size());
+    std::vector<unsigned> tree(MAX_SECTION + 2);
+    size_t added = 0;
+    for (auto i : order) {
+      for (; added < ranges.size() && ranges[added].min <= queries[i].min; added++)
+        for (size_t node = ranges[added].max + 1; node < tree.size(); node += node & -node)
+          tree[node]++;
+
+      size_t endingBefore = 0;
+      for (size_t node = queries[i].max; node > 0; node -= node & -node)
+        endingBefore += tree[node];
+      result[i] = added - endingBefore;
+    }
+
+    return result;
+  }
+
+private:
+  static constexpr size_t MAX_SECTION = UINT16_MAX;
+
+  std::vector<Range> ranges; // By start
+  std::vector<uint16_t> mins; // Starts of ranges, sorted
+  std::vector<uint16_t> maxs; // Ends of ranges, sorted
+};
+
+const aoc::Solver solver{
+  .parse = [](std::string_view input) {
+    Assignments assignments;
+    aoc::Scanner scanner(input);
+    scanner >> assignments;
+    return assignments;
+  },
+  .part1 = count<Contains>,
+  .part2 = count<Overlaps>,
+};
+
+// Usage: day4 --queries=file [input]
+// Prints for every range "a-b" in the file how many ranges of the input contain it and overlap it
+int query(const std::string& path) {
+  const auto input = aoc::openInput();
+  if (!input)
+    return 1;
+  const auto file = aoc::Input::open(path);
+  if (!file) {
+    std::cerr << "Unable to read " << path << '\n';
+    return 1;
+  }
+
+  const RangeIndex index(solver.parse(input->view()));
+
+  std::vector<Range> queries;
+  for (aoc::Scanner scanner(file->view()); !scanner.done();) {
+    const auto min = scanner.nextNumber<uint16_t>();
+    queries.emplace_back(min, scanner.nextNumber<uint16_t>());
+  }
+
+  const auto containing = index.containing(queries);
+  for (size_t i = 0; i < queries.size(); i++)
+    std::cout << queries[i].min << '-' << queries[i].max << ": " << containing[i] << " containing, " << index.overlapping(queries[i]) << " overlapping\n";
 
   return 0;
 }
+
+int main(int argc, char* argv[]) {
+  aoc::options = aoc::Options(argc, argv);
+  if (aoc::options.has("queries"))
+    return query(aoc::options.get("queries", ""));
+
+  return aoc::main(argc, argv, solver);
+}
@@ -1,8 +1,9 @@
 #include <iostream>
-#include <stack>
 #include <vector>
-#include <list>
 #include <string>
+#include <algorithm>
+
+#include "../common/aoc.h"
 
 struct Instruction {
   unsigned count = 0;
@@ -12,13 +13,16 @@ struct Instruction {
 
 class Cargo {
 public:
-  static Cargo parse() {
+  static Cargo parse(std::string_view input) {
     Cargo cargo;
+    aoc::Scanner scanner(input);
 
     // Stacks
-    std::string line;
-    std::vector<std::string> lines;
-    while (std::getline(std::cin, line) && !line.empty()) {
+    std::vector<std::string_view> lines;
+    while (!scanner.empty()) {
+      const auto line = scanner.line();
+      if (line.empty())
+        break;
       lines.push_back(line);
     }
 
@@ -28,56 +32,111 @@ public:
 
       cargo.stacks.emplace_back();
       for (int j = lines.size() - 2; j >= 0 && lines[j][i] != ' '; j--) {
-        cargo.stacks.back().push(lines[j][i]);
+        cargo.stacks.back() += lines[j][i];
       }
     }
 
     // Instructions
-    Instruction instr;
-    std::string unused;
-    while (std::cin >> unused >> instr.count >> unused >> instr.from >> unused >> instr.to)
+    while (!scanner.done()) {
+      Instruction instr;
+      instr.count = scanner.nextNumber<unsigned>();
+      instr.from = scanner.nextNumber<unsigned>();
+      instr.to = scanner.nextNumber<unsigned>();
       cargo.instructions.push_back(instr);
+    }
     return cargo;
   }
 
+  // Every move is a single block copy off the top of one stack onto another,
+  // reversed when the crates are moved one at a time. With --backward only the
+  // top crates are traced instead.
   std::string run(bool part2) const {
-    std::list<char> popped;
+    if (aoc::options.has("backward"))
+      return traceTops(part2);
+
     auto copy = stacks;
 
-    const auto pop = [&popped, &copy, part2](unsigned index) {
-      char c = copy[index].top();
-      if (part2)
-        popped.push_front(c);
-      else
-        popped.push_back(c);
-      copy[index].pop();
-    };
+    for (const auto& instr : instructions) {
+      auto& from = copy[instr.from - 1];
+      auto& to = copy[instr.to - 1];
+      if (&from == &to) // Lifting crates and putting them back leaves the stack as it was
+        continue;
 
-    for (const auto& instr: instructions) {
-      popped.clear();
-      for (unsigned i = 0; i < instr.count; i++) {
-        pop(instr.from - 1);
-      }
-      for (auto c : popped)
-        copy[instr.to - 1].push(c);
+      const auto top = from.end() - instr.count;
+      to.append(top, from.end());
+      if (!part2)
+        std::reverse(to.end() - instr.count, to.end());
+      from.erase(top, from.end());
     }
 
     std::string result;
     for (const auto& stack : copy) {
-      result += stack.top();
+      if (!stack.empty())
+        result += stack.back();
+    }
+    return result;
+  }
+
+  // Follows the final top of every stack back through the instructions to
+  // the crate it started as, in O(instructions * stacks) whatever the number
+  // of crates moved. Positions count down from the top of their stack.
+  std::string traceTops(bool part2) const {
+    std::vector<size_t> heights;
+    for (const auto& stack : stacks)
+      heights.push_back(stack.size());
+    for (const auto& instr : instructions) {
+      if (instr.from != instr.to) {
+        heights[instr.from - 1] -= instr.count;
+        heights[instr.to - 1] += instr.count;
+      }
     }
+
+    struct Position {
+      unsigned stack{};
+      size_t depth{};
+    };
+
+    std::vector<Position> tops;
+    for (unsigned i = 0; i < stacks.size(); i++)
+      if (heights[i] > 0)
+        tops.emplace_back(i, 0);
+
+    for (auto instr = instructions.rbegin(); instr != instructions.rend(); instr++) {
+      const unsigned from = instr->from - 1;
+      const unsigned to = instr->to - 1;
+      if (from == to)
+        continue;
+
+      for (auto& pos : tops) {
+        if (pos.stack == to && pos.depth < instr->count) {
+          pos.stack = from;
+          if (!part2)
+            pos.depth = instr->count - 1 - pos.depth;
+        } else if (pos.stack == to) {
+          pos.depth -= instr->count;
+        } else if (pos.stack == from) {
+          pos.depth += instr->count;
+        }
+      }
+    }
+
+    std::string result;
+    for (const auto& pos : tops)
+      result += stacks[pos.stack][stacks[pos.stack].size() - 1 - pos.depth];
     return result;
   }
 
 private:
-  std::vector<std::stack<char>> stacks;
+  std::vector<std::string> stacks; // Crates from the bottom up
   std::vector<Instruction> instructions;
 };
 
-int main() {
-  Cargo cargo = Cargo::parse();
+const aoc::Solver solver{
+  .parse = Cargo::parse,
+  .part1 = [](const Cargo& cargo) { return cargo.run(false); },
+  .part2 = [](const Cargo& cargo) { return cargo.run(true); },
+};
 
-  std::cout << "Part 1 result = " << cargo.run(false) << '\n';
-  std::cout << "Part 2 result = " << cargo.run(true) << '\n';
-  return 0;
+int main(int argc, char* argv[]) {
+  return aoc::main(argc, argv, solver);
 }
@@ -1,21 +1,150 @@
 #include <iostream>
 #include <string>
-#include <set>
+#include <array>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+#include <span>
+#include <numeric>
 
-size_t startOf(const std::string& datastream, size_t length) {
-  for (size_t i = length; i < datastream.size(); i++) {
-    std::set<char> previous(datastream.begin() + i - length, datastream.begin() + i);
-    if (previous.size() == length)
-      return i;
+#include "../common/aoc.h"
+
+// The last bytes of a stream with how often every byte value occurs among
+// them, to tell in O(1) per byte whether they are all different
+class Window {
+public:
+  static constexpr size_t MAX_LENGTH = 256; // Longer windows always repeat a byte
+
+  explicit Window(size_t length) : length(length) {
+    assert(length > 0 && length <= MAX_LENGTH);
+  }
+
+  // Adds the next byte, true when the window is full and has no repeats
+  bool push(uint8_t byte) {
+    if (pushed >= length) {
+      const auto oldest = bytes[(pushed - length) % MAX_LENGTH];
+      if (counts[oldest]-- == 2)
+        repeats--;
+    }
+
+    bytes[pushed % MAX_LENGTH] = byte;
+    if (++counts[byte] == 2)
+      repeats++;
+    pushed++;
+
+    return pushed >= length && repeats == 0;
+  }
+
+  // Bytes pushed so far, which is where a marker ends
+  size_t position() const {
+    return pushed;
   }
+
+private:
+  const size_t length;
+  std::array<uint8_t, MAX_LENGTH> bytes{}; // Ring of the last bytes
+  std::array<uint16_t, 256> counts{};
+  size_t repeats = 0; // Byte values occurring more than once
+  size_t pushed = 0;
+};
+
+size_t startOf(std::string_view datastream, size_t length) {
+  Window window(length);
+  for (const char c : datastream)
+    if (window.push(c))
+      return window.position();
   return 0;
 }
 
-int main() {
-  std::string datastream;
-  std::cin >> datastream;
+// First marker of every length in one pass, for any number of lengths.
+// Follows where the longest suffix without repeats starts, just after the
+// last earlier occurrence of any byte in it. A marker of a length ends at the
+// first byte where that suffix is at least as long.
+std::vector<size_t> startsOf(std::string_view datastream, std::span<const size_t> lengths) {
+  std::vector<size_t> order(lengths.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::ranges::sort(order, {}, [&lengths](size_t i) { return lengths[i]; });
+
+  std::vector<size_t> result(lengths.size());
+  std::array<size_t, 256> after{}; // Position just after the last occurrence of every byte
+  size_t start = 0;
+  size_t next = 0;
+  for (size_t i = 0; i < datastream.size() && next < order.size(); i++) {
+    auto& last = after[static_cast<uint8_t>(datastream[i])];
+    start = std::max(start, last);
+    last = i + 1;
+
+    for (; next < order.size() && i + 1 - start >= lengths[order[next]]; next++)
+      result[order[next]] = i + 1;
+  }
+
+  return result;
+}
+
+const aoc::Solver solver{
+  .parse = [](std::string_view input) { return aoc::Scanner(input).token(); },
+  .part1 = [](std::string_view datastream) { return startOf(datastream, 4); },
+  .part2 = [](std::string_view datastream) { return startOf(datastream, 14); },
+};
+
+// Usage: day6 --lengths=L1,L2,... [--bench] [input]
+// Prints the first marker of every length, or with --bench times finding them
+// all in one pass against calling startOf for each
+int lengths(const std::string& list) {
+  const auto input = aoc::openInput();
+  if (!input)
+    return 1;
+
+  std::vector<size_t> lengths;
+  for (aoc::Scanner scanner(list); !scanner.done();)
+    lengths.push_back(std::clamp<size_t>(scanner.nextNumber<size_t>(), 1, Window::MAX_LENGTH));
+
+  const auto datastream = solver.parse(input->view());
+  if (aoc::options.has("bench")) {
+    aoc::Bench bench(aoc::options.program, datastream.size(), aoc::options.get("warmup", 1), aoc::options.get("iterations", 10));
+    bench.measure("startOf", [&]() {
+      std::vector<size_t> result;
+      for (auto length : lengths)
+        result.push_back(startOf(datastream, length));
+      return result;
+    });
+    bench.measure("startsOf", [&]() { return startsOf(datastream, lengths); });
+    bench.printTable(std::cout);
+    return 0;
+  }
+
+  const auto starts = startsOf(datastream, lengths);
+  for (size_t i = 0; i < lengths.size(); i++)
+    std::cout << lengths[i] << ": " << starts[i] << '\n';
 
-  std::cout << "Part 1 result = " << startOf(datastream, 4) << '\n';
-  std::cout << "Part 2 result = " << startOf(datastream, 14) << '\n';
   return 0;
 }
+
+// Usage: day6 --markers=L [input]
+// Prints the end of every marker of length L, reading the datastream a block
+// at a time so it can be of any length
+int markers(size_t length) {
+  Window window(length);
+  const bool read = aoc::readInputBlocks([&window](std::string_view block) {
+    for (const char c : block) {
+      if (c == '\n')
+        return false;
+      if (window.push(c))
+        std::cout << window.position() << '\n';
+    }
+    return true;
+  });
+
+  return read ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+  aoc::options = aoc::Options(argc, argv);
+  if (aoc::options.has("markers"))
+    return markers(std::clamp<size_t>(aoc::options.get("markers", 4), 1, Window::MAX_LENGTH));
+  if (aoc::options.has("lengths"))
+    return lengths(aoc::options.get("lengths", ""));
+
+  return aoc::main(argc, argv, solver);
+}
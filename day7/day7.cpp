@@ -1,170 +1,257 @@
 #include <iostream>
 #include <vector>
-#include <map>
 #include <string>
-#include <sstream>
-#include <iterator>
-#include <memory>
-#include <numeric>
-#include <functional>
+#include <unordered_map>
+#include <set>
+#include <optional>
+#include <cstdint>
+#include <cassert>
 
-class Directory;
-class Object;
+#include "../common/aoc.h"
 
-using Func = std::function<void(const Object&)>;
-
-class Object {
+// Sizes of all directories in order, with the total of those small enough for
+// part 1 kept alongside, to answer both parts in O(log n) while sizes change
+class SizeIndex {
 public:
-  Object(Directory* parent) : parent(parent) {}
-
-  virtual ~Object() {}
+  static constexpr size_t SMALL = 100000;
 
-  virtual bool isDirectory() const = 0;
+  void insert(size_t size) {
+    sizes.insert(size);
+    if (size <= SMALL)
+      smallTotal += size;
+  }
 
-  virtual size_t size() const = 0;
+  void erase(size_t size) {
+    sizes.erase(sizes.find(size));
+    if (size <= SMALL)
+      smallTotal -= size;
+  }
 
-  virtual void foreach(const Func& f) const = 0;
+  size_t small() const {
+    return smallTotal;
+  }
 
-  Directory* getParent() const {
-    return parent;
+  // Smallest size of at least needed, if any
+  std::optional<size_t> smallest(size_t needed) const {
+    const auto it = sizes.lower_bound(needed);
+    return it == sizes.end() ? std::nullopt : std::optional(*it);
   }
 
 private:
-  Directory* parent;
+  std::multiset<size_t> sizes;
+  size_t smallTotal = 0;
 };
 
-class Directory : public Object {
+// Every directory in one array, linked to its parent by index, with the
+// total of the files directly in it. Names are interned so a subdirectory is
+// found by the ids of its parent and name. Directories are listed once, a
+// listing repeated later is skipped as it holds nothing new.
+//
+// A live file system instead keeps the size of every directory up to date as
+// files appear, and an index of them answering the parts after every sync.
+// Files are then tracked by name, so listing one again with another size
+// updates it.
+class FileSystem {
 public:
-  Directory(Directory* parent) : Object(parent) {}
+  using Id = uint32_t;
+
+  explicit FileSystem(bool live = false) {
+    if (live) {
+      index.emplace();
+      index->insert(0);
+    }
+  }
 
-  bool isDirectory() const override {
-    return true;
+  void cd(std::string_view name) {
+    if (name == "/")
+      cwd = ROOT;
+    else if (name == "..")
+      cwd = nodes[cwd].parent;
+    else
+      cwd = children.at(key(cwd, intern(name)));
   }
 
-  size_t size() const override {
-    return std::accumulate(objects.begin(), objects.end(), 0, [](const size_t& a, const auto& b) { return a + b.second->size(); });
+  void ls() {
+    listing = index || !nodes[cwd].listed;
+    nodes[cwd].listed = true;
   }
 
-  virtual void foreach(const Func& f) const override {
-    f(*this);
-    for (const auto& [name, object] : objects) {
-      object->foreach(f);
+  void mkdir(std::string_view name) {
+    if (name == "/" || !listing)
+      return;
+
+    if (children.try_emplace(key(cwd, intern(name)), nodes.size()).second) {
+      nodes.push_back({cwd});
+      if (index)
+        index->insert(0);
     }
   }
 
-  template <class T>
-  T* get(const std::string name) const {
-    return static_cast<T*>(objects.at(name).get());
-  }
+  void touch(std::string_view name, size_t size) {
+    if (!listing)
+      return;
+    if (!index) {
+      nodes[cwd].files += size;
+      return;
+    }
 
-  void add(const std::string& name, std::unique_ptr<Object> object) {
-    objects[name] = std::move(object);
+    // Shrinking wraps around, which the sums undo
+    auto& file = files[key(cwd, intern(name))];
+    const size_t delta = size - file;
+    file = size;
+    for (Id dir = cwd;; dir = nodes[dir].parent) {
+      nodes[dir].size += delta;
+      if (!nodes[dir].stale) {
+        nodes[dir].stale = true;
+        stale.push_back(dir);
+      }
+      if (dir == ROOT)
+        break;
+    }
   }
 
-private:
-  std::map<const std::string, std::unique_ptr<Object>> objects;
-};
+  // Brings the index of a live file system up to the sizes, once for every
+  // directory that changed since the last time however often it did
+  void sync() {
+    for (auto dir : stale) {
+      index->erase(nodes[dir].indexed);
+      index->insert(nodes[dir].size);
+      nodes[dir].indexed = nodes[dir].size;
+      nodes[dir].stale = false;
+    }
+    stale.clear();
+  }
 
-class File : public Object {
-public:
-  File(Directory* parent, size_t totalSize) : Object(parent), totalSize(totalSize) {}
+  // Sums the files below every directory. Subdirectories always come after
+  // their parent, so going backwards passes every one before its parent.
+  void du() {
+    for (auto& node : nodes)
+      node.size = node.files;
 
-  bool isDirectory() const override {
-    return false;
+    for (Id i = nodes.size() - 1; i > ROOT; i--)
+      nodes[nodes[i].parent].size += nodes[i].size;
   }
 
-  size_t size() const override {
-    return totalSize;
+  size_t part1() const {
+    assert(stale.empty());
+    if (index)
+      return index->small();
+
+    size_t result = 0;
+    for (const auto& node : nodes)
+      if (node.size <= 100000)
+        result += node.size;
+    return result;
   }
 
-  virtual void foreach(const Func& f) const override {
-    f(*this);
+  size_t part2() const {
+    assert(stale.empty());
+    size_t best = nodes[ROOT].size;
+    const size_t needed = nodes[ROOT].size + 30000000 - 70000000;
+    if (index)
+      return index->smallest(needed).value_or(best);
+
+    for (const auto& node : nodes)
+      if (node.size >= needed && node.size < best)
+        best = node.size;
+    return best;
   }
 
 private:
-  const size_t totalSize;
-};
+  static constexpr Id ROOT = 0;
+
+  struct Node {
+    Id parent{};
+    bool listed{};
+    bool stale{}; // Size changed since the index last caught up, when live
+    size_t files{}; // Directly in the directory, when not live
+    size_t size{}; // Of everything below, once du has run or when live
+    size_t indexed{}; // Size in the index, when live
+  };
 
-class FileSystem {
-public:
-  void cd(const std::string& name) {
-    if (name == "/")
-      cwd = &root;
-    else if (name == "..")
-      cwd = cwd->getParent();
-    else
-      cwd = cwd->get<Directory>(name);
+  // Copies a name only the first time it is seen
+  Id intern(std::string_view name) {
+    if (const auto it = names.find(name); it != names.end())
+      return it->second;
+    return names.emplace(name, names.size()).first->second;
   }
 
-  void mkdir(const std::string& name) {
-    if (name == "/")
-      return;
+  // Hashes strings and views alike, to look names up without a copy
+  struct Hash {
+    using is_transparent = void;
 
-    cwd->add(name, std::make_unique<Directory>(cwd));
-  }
+    size_t operator()(std::string_view name) const {
+      return std::hash<std::string_view>{}(name);
+    }
+  };
 
-  void touch(const std::string& name, size_t size) {
-    cwd->add(name, std::make_unique<File>(cwd, size));
+  static uint64_t key(Id parent, Id name) {
+    return uint64_t{parent} << 32 | name;
   }
 
-  void foreach(const Func& f) const {
-    root.foreach(f);
+  std::vector<Node> nodes{{ROOT}};
+  std::unordered_map<uint64_t, Id> children;
+  std::unordered_map<std::string, Id, Hash, std::equal_to<>> names;
+  std::unordered_map<uint64_t, size_t> files; // Sizes by directory and name, when live
+  std::optional<SizeIndex> index; // When live
+  std::vector<Id> stale; // Directories to update in the index
+  Id cwd = ROOT;
+  bool listing = false; // Whether the output being read is new
+};
+
+// Applies one line of a terminal log, passing names on as views into it
+void run(FileSystem& fs, std::string_view command) {
+  aoc::Scanner line(command);
+  const auto first = line.token();
+  const auto second = line.token();
+  if (first == "$") {
+    if (second == "cd") {
+      fs.cd(line.token());
+    } else if (second == "ls") {
+      fs.ls();
+    }
+  } else if (first == "dir") {
+    fs.mkdir(second);
+  } else if (!first.empty()) {
+    fs.touch(second, aoc::toNumber<size_t>(first));
   }
+}
 
-  size_t part1() const {
-    std::vector<size_t> sizes;
-    foreach([&sizes](const Object& o) {
-      if (auto size = o.size(); o.isDirectory() && size <= 100000)
-        sizes.push_back(size);
-    });
+FileSystem parse(std::string_view input) {
+  FileSystem fs;
+  for (aoc::Scanner scanner(input); !scanner.done();)
+    run(fs, scanner.line());
 
-    return std::accumulate(sizes.begin(), sizes.end(), 0);
-  }
+  fs.du();
+  return fs;
+}
 
-  size_t part2() const {
-    size_t best = root.size();
-    const size_t needed = root.size() + 30000000 - 70000000;
-    foreach([&best, &needed](const Object& o) {
-      if (auto size = o.size(); o.isDirectory() && size >= needed && size < best)
-        best = size;
-    });
-    return best;
-  }
-  
-private:
-  Directory root{nullptr};
-  Directory* cwd = &root;
+const aoc::Solver solver{
+  .parse = parse,
+  .part1 = [](const FileSystem& fs) { return fs.part1(); },
+  .part2 = [](const FileSystem& fs) { return fs.part2(); },
 };
 
-int main() {
-  const auto split = [](const std::string& s) -> std::vector<std::string> {
-    std::vector<std::string> result;
-    std::istringstream ss(s);
-    std::copy(std::istream_iterator<std::string>(ss), std::istream_iterator<std::string>(), std::back_inserter(result));
-    return result;
-  };
+// Usage: day7 --follow [input]
+// Reads the terminal log as it is written, for example from tail -f, and
+// after every batch of whole lines read prints both parts for the log so far
+int follow() {
+  FileSystem fs(true);
+  const bool read = aoc::readInputLines([&fs](std::string_view lines) {
+    for (aoc::Scanner scanner(lines); !scanner.empty();)
+      run(fs, scanner.line());
+    fs.sync();
 
-  std::vector<std::vector<std::string>> lines;
-  for (std::string line; std::getline(std::cin, line);)
-    lines.push_back(split(line));
+    std::cout << fs.part1() << ' ' << fs.part2() << std::endl;
+  });
 
-  FileSystem fs;
-  for (size_t i = 0; i < lines.size(); i++) {
-    const auto& line = lines[i];
-    if (line[0] == "$") {
-      if (line[1] == "cd") {
-        fs.cd(line[2]);
-      }
-    } else {
-      if (line[0] == "dir") {
-        fs.mkdir(line[1]);
-      } else {
-        fs.touch(line[1], std::stoul(line[0]));
-      }
-    }
-  }
-  
-  std::cout << "Part 1 result = " << fs.part1() << '\n';
-  std::cout << "Part 2 result = " << fs.part2() << '\n';
-  return 0;
+  return read ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+  aoc::options = aoc::Options(argc, argv);
+  if (aoc::options.has("follow"))
+    return follow();
+
+  return aoc::main(argc, argv, solver);
 }
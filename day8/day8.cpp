@@ -2,118 +2,373 @@
 #include <string>
 #include <vector>
 #include <array>
-#include <functional>
+#include <algorithm>
+#include <thread>
+#include <cstdint>
+#include <cstring>
 
-struct Pos {
-  int row{};
-  int col{};
+#include "../common/aoc.h"
+#include "../common/thread_pool.h"
 
-  auto operator<=>(const Pos& pos) const = default;
+// Trees are the digits '0' to '9'
+constexpr unsigned HEIGHTS = 10;
 
-  Pos& operator+=(const Pos& other) {
-    row += other.row;
-    col += other.col;
-    return *this;
+// Where the trees seen last along a line stand, for every height the position
+// of the last at least that high. The first tree to block the view from a new
+// one is the last seen at least as high. This is the monotonic stack of trees
+// still able to block a view, kept by height so updating it never branches.
+class Blockers {
+public:
+  // Viewing distance back from the tree of the given height at position i,
+  // which from then on blocks all trees up to its height
+  unsigned see(unsigned height, unsigned i) {
+    const auto distance = i - last[height];
+    for (unsigned h = 0; h < HEIGHTS; h++)
+      last[h] = h <= height ? i : last[h];
+    return distance;
+  }
+
+  // Position of the last tree seen at least as high, 0 for none
+  unsigned blocker(unsigned height) const {
+    return last[height];
+  }
+
+  // Adds the trees seen by another further along the line
+  void merge(const Blockers& other) {
+    for (unsigned h = 0; h < HEIGHTS; h++)
+      last[h] = std::max(last[h], other.last[h]);
+  }
+
+private:
+  std::array<unsigned, HEIGHTS> last{};
+};
+
+// Trees of a column whose view down is not blocked yet, with their scores in
+// the other directions. A tree blocks the view of all up to its height, so
+// at most one of every height is waiting.
+class Waiting {
+public:
+  // Ends the views of the waiting trees up to the height of a new tree at
+  // the row, returning the best score among them, then lets the new one wait
+  uint64_t see(unsigned height, unsigned row, uint64_t score) {
+    uint64_t best = 0;
+    for (unsigned h = 0; h <= height; h++) {
+      best = std::max(best, scores[h] * (row - rows[h]));
+      scores[h] = 0;
+    }
+    scores[height] = score;
+    rows[height] = row;
+    return best;
   }
+
+  // Ends the views of all waiting trees, blocked at the row given for every height
+  template <class F>
+  uint64_t end(F&& blocker) const {
+    uint64_t best = 0;
+    for (unsigned h = 0; h < HEIGHTS; h++)
+      best = std::max(best, scores[h] * (blocker(h) - rows[h]));
+    return best;
+  }
+
+private:
+  std::array<uint64_t, HEIGHTS> scores{}; // 0 where none is waiting
+  std::array<unsigned, HEIGHTS> rows{};
 };
 
-Pos operator+(Pos left, const Pos& right) {
-  left += right;
-  return left;
+// Thirty-two columns at once, comparisons giving -1 where they hold
+using Columns = uint8_t __attribute__((vector_size(32)));
+using Mask = int8_t __attribute__((vector_size(32)));
+
+template <class V>
+void load(V& v, const uint8_t* from) {
+  std::memcpy(&v, from, sizeof(V));
+}
+
+template <class V>
+void store(uint8_t* to, const V& v) {
+  std::memcpy(to, &v, sizeof(V));
 }
 
+// The rows are split into a band per thread. With several, a first pass sums
+// up what every column of a band holds, and combining those tells every band
+// what lies above and below it. A second pass sweeps every band from the top, looking
+// left and right along the rows and up the columns, with the trees still
+// waiting for one at least as high below them when looking down.
 class Grid {
 public:
-  friend std::istream& operator>>(std::istream& is, Grid& grid);
+  friend aoc::Scanner& operator>>(aoc::Scanner& scanner, Grid& grid);
 
-  bool inside(const Pos& pos) const {
-    return pos.row >= 0 && static_cast<size_t>(pos.row) < grid.size() && pos.col >= 0 && static_cast<size_t>(pos.col) < grid[pos.row].size();
+  size_t size() const {
+    return rows * cols;
   }
 
-  char at(const Pos& pos) const {
-    return grid[pos.row][pos.col];
+  size_t visibleFromOutside(size_t threads) const {
+    const auto bounds = bands(threads);
+    const size_t count = bounds.size() - 1;
+
+    // Highest tree of every column in every band, then above and below them
+    std::vector<std::vector<uint8_t>> highest(count, std::vector<uint8_t>(stride));
+    parallel(count > 1 ? count : 0, [&](size_t band) {
+      for (size_t row = bounds[band]; row < bounds[band + 1]; row++)
+        raise(highest[band].data(), trees.data() + row * stride);
+    });
+
+    std::vector<std::vector<uint8_t>> above(count, std::vector<uint8_t>(stride));
+    std::vector<std::vector<uint8_t>> below(count, std::vector<uint8_t>(stride));
+    for (size_t band = 1; band < count; band++) {
+      above[band] = above[band - 1];
+      raise(above[band].data(), highest[band - 1].data());
+    }
+    for (size_t band = count - 1; band-- > 0;) {
+      below[band] = below[band + 1];
+      raise(below[band].data(), highest[band + 1].data());
+    }
+
+    std::vector<size_t> visible(count);
+    parallel(count, [&](size_t band) { visible[band] = visibleIn(bounds[band], bounds[band + 1], std::move(above[band]), below[band]); });
+
+    size_t result = 0;
+    for (auto v : visible)
+      result += v;
+    return result;
   }
 
-  unsigned visibleFromOutside() const {
-    unsigned count = 0;
+  uint64_t maxScenicScore(size_t threads) const {
+    const auto bounds = bands(threads);
+    const size_t count = bounds.size() - 1;
 
-    foreach([&count, this](Pos current) {
-      const auto height = at(current);
-      for (const auto& offset : OFFSETS) {
-        for (auto pos = current + offset;; pos += offset) {
-          if (!inside(pos)) {
-            count++;
-            return;
-          } else if (at(pos) >= height) {
-            break;
-          }
-        }
-      }
+    // What is seen looking down into every band and looking up into it, with
+    // positions counted from the bottom for the latter, then what every band
+    // sees above and below it
+    std::vector<std::vector<Blockers>> down(count, std::vector<Blockers>(cols));
+    std::vector<std::vector<Blockers>> up(count, std::vector<Blockers>(cols));
+    parallel(count > 1 ? count : 0, [&](size_t band) {
+      for (size_t row = bounds[band]; row < bounds[band + 1]; row++)
+        for (size_t col = 0; col < cols; col++)
+          down[band][col].see(height(row, col), row);
+      for (size_t row = bounds[band + 1]; row-- > bounds[band];)
+        for (size_t col = 0; col < cols; col++)
+          up[band][col].see(height(row, col), rows - 1 - row);
     });
 
-    return count;
+    std::vector<std::vector<Blockers>> above(count, std::vector<Blockers>(cols));
+    std::vector<std::vector<Blockers>> below(count, std::vector<Blockers>(cols));
+    for (size_t band = 1; band < count; band++) {
+      above[band] = above[band - 1];
+      for (size_t col = 0; col < cols; col++)
+        above[band][col].merge(down[band - 1][col]);
+    }
+    for (size_t band = count - 1; band-- > 0;) {
+      below[band] = below[band + 1];
+      for (size_t col = 0; col < cols; col++)
+        below[band][col].merge(up[band + 1][col]);
+    }
+
+    std::vector<uint64_t> best(count);
+    parallel(count, [&](size_t band) { best[band] = bestIn(bounds[band], bounds[band + 1], std::move(above[band]), below[band]); });
+    return *std::ranges::max_element(best);
   }
 
+private:
+  static constexpr size_t LANES = sizeof(Columns);
 
-  unsigned maxScenicScore() const {
-    unsigned max = 0;
+  // Bounds of the bands, of at least a megabyte of trees each
+  std::vector<size_t> bands(size_t threads) const {
+    static constexpr size_t MIN_CHUNK = 1 << 20;
 
-    foreach([&max, this](Pos current) {
-      if (auto score = scenicScore(current); score > max)
-        max = score;
-    });
+    const size_t count = std::clamp<size_t>(std::min(threads, size() / MIN_CHUNK), 1, std::max<size_t>(rows, 1));
+    std::vector<size_t> bounds;
+    for (size_t band = 0; band <= count; band++)
+      bounds.push_back(band * rows / count);
+    return bounds;
+  }
+
+  // Runs f for 0 to count - 1, each on its own thread when there are several
+  template <class F>
+  static void parallel(size_t count, F&& f) {
+    if (count < 2) {
+      for (size_t i = 0; i < count; i++)
+        f(i);
+      return;
+    }
 
-    return max;
+    aoc::ThreadPool pool(count);
+    for (size_t i = 0; i < count; i++)
+      pool.submit([&f, i]() { f(i); });
+    pool.wait();
   }
 
-private:
-  static constexpr std::array<Pos, 4> OFFSETS{Pos{1, 0}, Pos{-1, 0}, Pos{0, 1}, Pos{0, -1}};
+  unsigned height(size_t row, size_t col) const {
+    return trees[row * stride + col] - '0';
+  }
+
+  // Raises every column to the tree of the other row
+  void raise(uint8_t* row, const uint8_t* other) const {
+    for (size_t col = 0; col < stride; col += LANES) {
+      Columns a, b;
+      load(a, row + col);
+      load(b, other + col);
+      store(row + col, a > b ? a : b);
+    }
+  }
+
+  // Trees of the band visible from outside, given the highest tree of every
+  // column above and below it. A tree hidden from the left, the right and
+  // above waits to be hidden from below as well, and those still waiting at
+  // the end of the band are seen if higher than all below. Built for AVX2 as
+  // well as the baseline, picked when the program starts.
+#ifdef __x86_64__
+  [[gnu::target_clones("avx2", "default")]]
+#endif
+  size_t visibleIn(size_t begin, size_t end, std::vector<uint8_t> highest, const std::vector<uint8_t>& below) const {
+    static constexpr size_t FLUSH = UINT8_MAX;
+
+    std::vector<uint8_t> sides(stride); // -1 for the trees of the row seen from the left or the right
+    std::vector<uint8_t> counts(stride); // Trees seen in every column since the last flush
+    std::array<std::vector<uint8_t>, HEIGHTS> waiting; // -1 for the tree of every column waiting, by height
+    waiting.fill(std::vector<uint8_t>(stride));
 
-  void foreach(const std::function<void(Pos)>& f) const {
-    for (size_t row = 0; row < grid.size(); row++) {
-      for (size_t col = 0; col < grid[row].size(); col++) {
-        f(Pos(row, col));
+    size_t result = 0;
+    const auto flush = [&]() {
+      for (auto& count : counts) {
+        result += count;
+        count = 0;
       }
+    };
+
+    for (size_t row = begin; row < end; row++) {
+      const uint8_t* line = trees.data() + row * stride;
+      uint8_t left = 0;
+      for (size_t col = 0; col < cols; left = std::max(left, line[col++]))
+        sides[col] = line[col] > left ? 0xFF : 0;
+      uint8_t right = 0;
+      for (size_t col = cols; col-- > 0; right = std::max(right, line[col]))
+        sides[col] |= line[col] > right ? 0xFF : 0;
+
+      for (size_t col = 0; col < stride; col += LANES) {
+        Columns tree, high, count;
+        Mask side;
+        load(tree, line + col);
+        load(high, highest.data() + col);
+        load(side, sides.data() + col);
+        load(count, counts.data() + col);
+
+        const Mask seen = side | (tree > high);
+        store(counts.data() + col, count - __builtin_convertvector(seen, Columns));
+        store(highest.data() + col, tree > high ? tree : high);
+
+        for (unsigned h = 0; h < HEIGHTS; h++) {
+          const Columns level = Columns{} + static_cast<uint8_t>('0' + h);
+          Mask wait;
+          load(wait, waiting[h].data() + col);
+          store(waiting[h].data() + col, (wait & ~(tree >= level)) | ((tree == level) & ~seen));
+        }
+      }
+
+      if ((row - begin) % FLUSH == FLUSH - 1)
+        flush();
     }
+    flush();
+
+    for (unsigned h = 0; h < HEIGHTS; h++)
+      for (size_t col = 0; col < cols; col++)
+        result += waiting[h][col] && '0' + h > below[col];
+
+    return result;
   }
 
-  unsigned scenicScore(const Pos& current) const {
-    unsigned score = 1;
+  // Highest score of the trees of the band, given what every column sees
+  // above and below it
+  uint64_t bestIn(size_t begin, size_t end, std::vector<Blockers> above, const std::vector<Blockers>& below) const {
+    std::vector<Waiting> waiting(cols);
+    std::vector<unsigned> right(cols);
+
+    uint64_t best = 0;
+    for (size_t row = begin; row < end; row++) {
+      Blockers fromRight;
+      for (size_t col = cols; col-- > 0;)
+        right[col] = fromRight.see(height(row, col), cols - 1 - col);
 
-    for (const auto& offset : OFFSETS) {
-      unsigned viewing = 0;
-      auto height = at(current);
-      for (auto pos = current + offset; inside(pos); pos += offset) {
-        viewing++;
-        if (at(pos) >= height)
-          break;
+      Blockers fromLeft;
+      for (size_t col = 0; col < cols; col++) {
+        const auto tree = height(row, col);
+        const uint64_t score = uint64_t{fromLeft.see(tree, col)} * right[col] * above[col].see(tree, row);
+        best = std::max(best, waiting[col].see(tree, row, score));
       }
-      score *= viewing;
     }
 
-    return score;
+    for (size_t col = 0; col < cols; col++)
+      best = std::max(best, waiting[col].end([&](unsigned h) { return rows - 1 - below[col].blocker(h); }));
+
+    return best;
   }
 
-  std::vector<std::string> grid;
+  std::vector<uint8_t> trees; // Row after row, each padded with zeros to whole vectors
+  size_t rows = 0;
+  size_t cols = 0;
+  size_t stride = 0;
 };
 
-std::istream& operator>>(std::istream& is, Grid& grid) {
-  std::string line;
+aoc::Scanner& operator>>(aoc::Scanner& scanner, Grid& grid) {
+  while (!scanner.done()) {
+    const auto line = scanner.token();
+    if (grid.rows == 0) {
+      grid.cols = line.size();
+      grid.stride = (line.size() + Grid::LANES - 1) / Grid::LANES * Grid::LANES;
+    }
 
-  while (is >> line)
-    grid.grid.push_back(line);
+    grid.trees.resize(grid.trees.size() + grid.stride);
+    std::ranges::copy(line.substr(0, grid.cols), grid.trees.end() - grid.stride);
+    grid.rows++;
+  }
 
-  return is;
+  return scanner;
 }
 
+// Set with --threads=N, by default all cores
+size_t threads() {
+  return aoc::options.get("threads", std::thread::hardware_concurrency());
+}
 
-int main() {
-  Grid grid;
+const aoc::Solver solver{
+  .parse = [](std::string_view input) {
+    Grid grid;
+    aoc::Scanner scanner(input);
+    scanner >> grid;
+    return grid;
+  },
+  .part1 = [](const Grid& grid) { return grid.visibleFromOutside(threads()); },
+  .part2 = [](const Grid& grid) { return grid.maxScenicScore(threads()); },
+};
 
-  std::cin >> grid;
+// Usage: day8 --scaling [--json] [input]
+// Times both parts on 1, 2, 4, ... threads up to all cores
+int scaling() {
+  const auto input = aoc::openInput();
+  if (!input)
+    return 1;
 
-  std::cout << "Part 1 result = " << grid.visibleFromOutside() << '\n';
-  std::cout << "Part 2 result = " << grid.maxScenicScore() << '\n';
+  const auto grid = solver.parse(input->view());
+  const size_t cores = std::max(std::thread::hardware_concurrency(), 1u);
+  aoc::Bench bench(aoc::options.program, input->view().size(), aoc::options.get("warmup", 1), aoc::options.get("iterations", 10));
+  for (size_t threads = 1;; threads = std::min(2 * threads, cores)) {
+    bench.measure("part1 x" + std::to_string(threads), [&]() { return grid.visibleFromOutside(threads); });
+    bench.measure("part2 x" + std::to_string(threads), [&]() { return grid.maxScenicScore(threads); });
+    if (threads == cores)
+      break;
+  }
 
+  if (aoc::options.has("json"))
+    bench.printJson(std::cout);
+  else
+    bench.printTable(std::cout);
   return 0;
 }
+
+int main(int argc, char* argv[]) {
+  aoc::options = aoc::Options(argc, argv);
+  if (aoc::options.has("scaling"))
+    return scaling();
+
+  return aoc::main(argc, argv, solver);
+}
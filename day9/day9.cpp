@@ -1,90 +1,273 @@
 #include <iostream>
-#include <set>
 #include <array>
+#include <vector>
+#include <string>
+#include <span>
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+#include "../common/aoc.h"
 
 struct Pos {
   int x{};
   int y{};
 
   auto operator<=>(const Pos& pos) const = default;
+};
+
+// Set of positions as tiles of 64 by 64 bits, a word per row, which an open
+// addressing hash table finds by their coordinates. Steps mostly stay on the
+// tile of the step before, which is kept at hand.
+class Visited {
+public:
+  Visited() : last(tile(lastKey)) {
+    insert(Pos{});
+  }
 
-  Pos& operator+=(const Pos& other) {
-    x += other.x;
-    y += other.y;
-    return *this;
+  void insert(const Pos& pos) {
+    auto& row = tileAt(pos.x, pos.y)[pos.y & (TILE - 1)];
+    const auto bit = uint64_t{1} << (pos.x & (TILE - 1));
+    count += (row & bit) == 0;
+    row |= bit;
   }
 
-  bool adjacent(const Pos& other) {
-    return std::abs(x - other.x) <= 1 && std::abs(y - other.y) <= 1;
+  // All positions of a horizontal or vertical line, a row at a time and a
+  // word of a row at a time
+  void insert(const Pos& from, const Pos& to) {
+    const auto [minX, maxX] = std::minmax(from.x, to.x);
+    const auto [minY, maxY] = std::minmax(from.y, to.y);
+    for (int y = minY; y <= maxY; y++) {
+      for (int x = minX, end;; x = end + 1) {
+        end = std::min(maxX, x | (TILE - 1));
+        const auto bits = (~uint64_t{} >> (TILE - 1 - (end & (TILE - 1)))) & (~uint64_t{} << (x & (TILE - 1)));
+        auto& row = tileAt(x, y)[y & (TILE - 1)];
+        count += std::popcount(bits & ~row);
+        row |= bits;
+        if (end == maxX)
+          break;
+      }
+    }
   }
 
-  void moveTowards(const Pos& other) {
-    if (adjacent(other))
-      return;
+  size_t size() const {
+    return count;
+  }
+
+private:
+  static constexpr int TILE = 64;
+  static constexpr uint32_t NONE = UINT32_MAX;
+
+  using Tile = std::array<uint64_t, TILE>;
+
+  struct Slot {
+    uint64_t key{};
+    uint32_t tile = NONE;
+  };
+
+  static uint64_t tileKey(const Pos& pos) {
+    return uint64_t{static_cast<uint32_t>(pos.x >> 6)} << 32 | static_cast<uint32_t>(pos.y >> 6);
+  }
 
-    if (x != other.x) {
-      x += x < other.x ? 1 : -1;
+  Tile& tileAt(int x, int y) {
+    const auto key = tileKey(Pos{x, y});
+    if (key != lastKey) {
+      last = tile(key);
+      lastKey = key;
     }
-    if (y != other.y) {
-      y += y < other.y ? 1 : -1;
+    return tiles[last];
+  }
+
+  static size_t hash(uint64_t key) {
+    return (key * 0x9E3779B97F4A7C15) >> 32;
+  }
+
+  // Index of the tile, added if new. The table is kept at most half full.
+  uint32_t tile(uint64_t key) {
+    const size_t mask = slots.size() - 1;
+    for (size_t i = hash(key) & mask;; i = (i + 1) & mask) {
+      if (slots[i].key == key && slots[i].tile != NONE)
+        return slots[i].tile;
+      if (slots[i].tile == NONE) {
+        if (2 * (tiles.size() + 1) > slots.size()) {
+          grow();
+          return tile(key);
+        }
+        slots[i] = {key, static_cast<uint32_t>(tiles.size())};
+        tiles.emplace_back();
+        return slots[i].tile;
+      }
     }
   }
-};
 
-Pos operator+(Pos left, const Pos& right) {
-  left += right;
-  return left;
-}
+  void grow() {
+    std::vector<Slot> old(2 * slots.size());
+    std::swap(old, slots);
+    const size_t mask = slots.size() - 1;
+    for (const auto& slot : old) {
+      if (slot.tile == NONE)
+        continue;
+      size_t i = hash(slot.key) & mask;
+      while (slots[i].tile != NONE)
+        i = (i + 1) & mask;
+      slots[i] = slot;
+    }
+  }
+
+  std::vector<Tile> tiles;
+  std::vector<Slot> slots = std::vector<Slot>(16);
+  uint64_t lastKey = tileKey(Pos{});
+  uint32_t last; // Tile of lastKey
+  size_t count = 0;
+};
 
-template <size_t size>
+// Knots of a rope in an array per coordinate, with the positions visited by
+// some of them. A knot follows the same path in every rope long enough to
+// have it, so the longest rope gives the tails of all shorter ones in one go.
 class Rope {
 public:
+  // The longest of the lengths, following the tail of a rope of every length
+  explicit Rope(std::span<const size_t> lengths, bool stepwise = false) : stepwise(stepwise) {
+    for (auto length : lengths)
+      tails.push_back(std::max<size_t>(length, 1) - 1);
+
+    const size_t knots = *std::ranges::max_element(tails) + 1;
+    xs.resize(knots);
+    ys.resize(knots);
+    tracking.resize(knots, NONE);
+    for (auto tail : tails) {
+      if (tracking[tail] == NONE) {
+        tracking[tail] = visited.size();
+        visited.emplace_back();
+      }
+    }
+  }
+
+  // Every knot follows the one before it until one is close enough not to
+  // move, when none after it moves either. Once every knot lies straight
+  // behind the one before it, the rest of the motion moves them all alike,
+  // which is done in one go unless stepwise.
   void move(char c, unsigned amount) {
+    const auto [dx, dy] = offset(c);
     for (unsigned i = 0; i < amount; i++) {
-      switch (c) {
-        case 'U':
-          knots.front().y--;
-          break;
-        case 'R':
-          knots.front().x++;
-          break;
-        case 'D':
-          knots.front().y++;
-          break;
-        case 'L':
-          knots.front().x--;
-          break;
-        default:
+      xs[0] += dx;
+      ys[0] += dy;
+      track(0);
+
+      bool straight = true; // All knots moved and now trail by the motion
+      for (size_t k = 1; k < xs.size(); k++) {
+        const int distanceX = xs[k - 1] - xs[k];
+        const int distanceY = ys[k - 1] - ys[k];
+        if (std::abs(distanceX) <= 1 && std::abs(distanceY) <= 1) {
+          straight = false;
           break;
+        }
+
+        xs[k] += (distanceX > 0) - (distanceX < 0);
+        ys[k] += (distanceY > 0) - (distanceY < 0);
+        straight = straight && xs[k - 1] - xs[k] == dx && ys[k - 1] - ys[k] == dy;
+        track(k);
       }
 
-      for (size_t i = 1; i < knots.size(); i++)
-        knots[i].moveTowards(knots[i - 1]);
-      visited.insert(knots.back());
+      if (straight && !stepwise) {
+        shift(dx * static_cast<int>(amount - i - 1), dy * static_cast<int>(amount - i - 1));
+        break;
+      }
     }
   }
 
-  size_t visitCount() const {
-    return visited.size();
+  // By the lengths the rope was made with
+  std::vector<size_t> visitCounts() const {
+    std::vector<size_t> result;
+    for (auto tail : tails)
+      result.push_back(visited[tracking[tail]].size());
+    return result;
   }
 
 private:
-  std::array<Pos, size> knots{};
-  std::set<Pos> visited{Pos{}};
-};
+  static constexpr uint32_t NONE = UINT32_MAX;
 
-int main() {
-  char direction;
-  unsigned amount;
-  Rope<2> rope1;
-  Rope<10> rope2;
+  static Pos offset(char c) {
+    switch (c) {
+      case 'U':
+        return {0, -1};
+      case 'R':
+        return {1, 0};
+      case 'D':
+        return {0, 1};
+      case 'L':
+        return {-1, 0};
+      default:
+        return {};
+    }
+  }
+
+  // Moves every knot by the same offset along a line
+  void shift(int dx, int dy) {
+    for (size_t k = 0; k < xs.size(); k++) {
+      const Pos from{xs[k], ys[k]};
+      xs[k] += dx;
+      ys[k] += dy;
+      if (tracking[k] != NONE)
+        visited[tracking[k]].insert(from, Pos{xs[k], ys[k]});
+    }
+  }
 
-  while (std::cin >> direction >> amount) {
-    rope1.move(direction, amount);
-    rope2.move(direction, amount);
+  void track(size_t knot) {
+    if (tracking[knot] != NONE)
+      visited[tracking[knot]].insert(Pos{xs[knot], ys[knot]});
   }
 
-  std::cout << "Part 1 result = " << rope1.visitCount() << '\n';
-  std::cout << "Part 2 result = " << rope2.visitCount() << '\n';
+  std::vector<int> xs;
+  std::vector<int> ys;
+  std::vector<uint32_t> tracking; // Index into visited for every knot, NONE for those not followed
+  std::vector<Visited> visited;
+  std::vector<size_t> tails; // Knot at the end of every length
+  bool stepwise;
+};
+
+// Tails of ropes of every length, all from one pass over the motions. Set
+// --stepwise to move the knots a step at a time all the way.
+std::vector<size_t> simulate(std::string_view input, std::span<const size_t> lengths) {
+  Rope rope(lengths, aoc::options.has("stepwise"));
+  for (aoc::Scanner scanner(input); !scanner.done();) {
+    const char direction = scanner.token().front();
+    rope.move(direction, scanner.number<unsigned>());
+  }
+
+  return rope.visitCounts();
+}
+
+const aoc::Solver solver{
+  .parse = [](std::string_view input) { return simulate(input, std::array<size_t, 2>{2, 10}); },
+  .part1 = [](const std::vector<size_t>& counts) { return counts[0]; },
+  .part2 = [](const std::vector<size_t>& counts) { return counts[1]; },
+};
+
+// Usage: day9 --lengths=L1,L2,... [input]
+// Prints how many positions the tail of a rope of every length visits
+int lengths(const std::string& list) {
+  const auto input = aoc::openInput();
+  if (!input)
+    return 1;
+
+  std::vector<size_t> lengths;
+  for (aoc::Scanner scanner(list); !scanner.done();)
+    lengths.push_back(scanner.nextNumber<size_t>());
+  if (lengths.empty())
+    return 0;
+
+  const auto counts = simulate(input->view(), lengths);
+  for (size_t i = 0; i < lengths.size(); i++)
+    std::cout << lengths[i] << ": " << counts[i] << '\n';
+
   return 0;
 }
+
+int main(int argc, char* argv[]) {
+  aoc::options = aoc::Options(argc, argv);
+  if (aoc::options.has("lengths"))
+    return lengths(aoc::options.get("lengths", ""));
+
+  return aoc::main(argc, argv, solver);
+}
@@ -0,0 +1,691 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <array>
+#include <set>
+#include <map>
+#include <unordered_set>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <iterator>
+#include <functional>
+#include <cstdint>
+#include <cassert>
+
+#include "../common/aoc.h"
+
+// Random inputs in the format of every day, scaled by a single size parameter,
+// to measure how the solvers scale beyond the puzzle inputs.
+
+class Random {
+public:
+  Random(uint64_t seed) : engine(seed) {}
+
+  // Inclusive on both ends
+  int64_t between(int64_t min, int64_t max) {
+    return std::uniform_int_distribution<int64_t>(min, max)(engine);
+  }
+
+  bool chance(double p) {
+    return std::bernoulli_distribution(p)(engine);
+  }
+
+  template <class T>
+  const T& pick(const std::vector<T>& v) {
+    return v[between(0, v.size() - 1)];
+  }
+
+  template <class T>
+  void shuffle(std::vector<T>& v) {
+    std::ranges::shuffle(v, engine);
+  }
+
+private:
+  std::mt19937_64 engine;
+};
+
+using Generator = std::function<void(std::ostream&, unsigned, Random&)>;
+
+// Lowercase name unique to the given id, at least the given length
+std::string name(uint64_t id, size_t length = 1) {
+  std::string result;
+  do {
+    result += 'a' + id % 26;
+    id /= 26;
+  } while (id > 0 || result.size() < length);
+  return result;
+}
+
+// size = elves
+void day1(std::ostream& out, unsigned size, Random& random) {
+  for (unsigned elf = 0; elf < size; elf++) {
+    if (elf > 0)
+      out << '\n';
+    for (auto items = random.between(1, 15); items > 0; items--)
+      out << random.between(1000, 60000) << '\n';
+  }
+}
+
+// size = rounds
+void day2(std::ostream& out, unsigned size, Random& random) {
+  for (unsigned round = 0; round < size; round++)
+    out << static_cast<char>('A' + random.between(0, 2)) << ' ' << static_cast<char>('X' + random.between(0, 2)) << '\n';
+}
+
+// size = rucksacks, rounded up to whole groups. Every rucksack has exactly one
+// item in both compartments and every group exactly one item in common.
+void day3(std::ostream& out, unsigned size, Random& random) {
+  std::vector<char> items;
+  for (char c = 'a'; c <= 'z'; c++)
+    items.push_back(c);
+  for (char c = 'A'; c <= 'Z'; c++)
+    items.push_back(c);
+
+  for (unsigned group = 0; group < (size + 2) / 3; group++) {
+    random.shuffle(items);
+    const char badge = items.back();
+
+    for (unsigned elf = 0; elf < 3; elf++) {
+      // 17 private items per elf, split between the compartments except the shared one
+      const auto first = items.begin() + elf * 17;
+      const char shared = first[0];
+      const std::vector<char> left(first + 1, first + 9);
+      const std::vector<char> right(first + 9, first + 17);
+
+      const auto length = random.between(4, 24);
+      std::string compartment1{shared};
+      std::string compartment2{shared, badge};
+      while (static_cast<int64_t>(compartment1.size()) < length)
+        compartment1 += random.pick(left);
+      while (static_cast<int64_t>(compartment2.size()) < length)
+        compartment2 += random.pick(right);
+      std::ranges::shuffle(compartment1, std::mt19937(random.between(0, 1 << 30)));
+      std::ranges::shuffle(compartment2, std::mt19937(random.between(0, 1 << 30)));
+
+      out << compartment1 << compartment2 << '\n';
+    }
+  }
+}
+
+// size = pairs
+void day4(std::ostream& out, unsigned size, Random& random) {
+  for (unsigned pair = 0; pair < size; pair++) {
+    const auto min1 = random.between(1, 99), min2 = random.between(1, 99);
+    out << min1 << '-' << random.between(min1, 99) << ',' << min2 << '-' << random.between(min2, 99) << '\n';
+  }
+}
+
+// size = instructions. Stacks grow with the size and never run empty.
+void day5(std::ostream& out, unsigned size, Random& random) {
+  static constexpr unsigned STACKS = 9;
+
+  std::array<std::string, STACKS> stacks;
+  for (auto& stack : stacks)
+    for (auto height = random.between(2, std::max<int64_t>(8, size / 100)); height > 0; height--)
+      stack += 'A' + random.between(0, 25);
+
+  size_t height = std::ranges::max_element(stacks, {}, &std::string::size)->size();
+  for (size_t row = height; row > 0; row--) {
+    for (unsigned i = 0; i < STACKS; i++) {
+      if (i > 0)
+        out << ' ';
+      if (stacks[i].size() >= row)
+        out << '[' << stacks[i][row - 1] << ']';
+      else
+        out << "   ";
+    }
+    out << '\n';
+  }
+  for (unsigned i = 0; i < STACKS; i++)
+    out << ' ' << i + 1 << "  ";
+  out << "\n\n";
+
+  std::array<size_t, STACKS> heights;
+  for (unsigned i = 0; i < STACKS; i++)
+    heights[i] = stacks[i].size();
+
+  for (unsigned instr = 0; instr < size; instr++) {
+    unsigned from, to;
+    do {
+      from = random.between(0, STACKS - 1);
+    } while (heights[from] < 2);
+    do {
+      to = random.between(0, STACKS - 1);
+    } while (to == from);
+
+    const auto count = random.between(1, heights[from] - 1);
+    heights[from] -= count;
+    heights[to] += count;
+    out << "move " << count << " from " << from + 1 << " to " << to + 1 << '\n';
+  }
+}
+
+// size = characters. Markers only show up at the very end.
+void day6(std::ostream& out, unsigned size, Random& random) {
+  static const std::string MARKER = "defghijklmnopq";
+
+  std::string datastream;
+  while (datastream.size() + MARKER.size() < size)
+    datastream += 'a' + random.between(0, 2);
+  out << datastream << MARKER << '\n';
+}
+
+// size = files, spread over size / 4 directories. The files fill between 40M
+// and 70M of the disk, so part 2 always has to and can free up space.
+void day7(std::ostream& out, unsigned size, Random& random) {
+  struct Directory {
+    std::vector<unsigned> children;
+    unsigned files{};
+  };
+
+  std::vector<Directory> directories(std::max(1u, size / 4));
+  for (unsigned i = 1; i < directories.size(); i++)
+    directories[random.between(0, i - 1)].children.push_back(i);
+  for (unsigned i = 0; i < size; i++)
+    directories[random.between(0, directories.size() - 1)].files++;
+
+  std::vector<uint64_t> sizes(size);
+  for (auto& file : sizes)
+    file = random.between(1, 300000);
+  const uint64_t used = random.between(42000000, 69000000);
+  const uint64_t total = std::accumulate(sizes.begin(), sizes.end(), uint64_t{});
+  for (auto& file : sizes)
+    file = std::max<uint64_t>(1, file * used / total);
+  auto nextSize = sizes.begin();
+
+  // Depth first, without recursion since the tree can be deep
+  out << "$ cd /\n";
+  std::vector<std::pair<unsigned, size_t>> stack{{0, 0}};
+  while (!stack.empty()) {
+    auto& [id, next] = stack.back();
+    const auto& directory = directories[id];
+    if (next == 0) {
+      out << "$ ls\n";
+      for (auto child : directory.children)
+        out << "dir " << name(child) << '\n';
+      for (unsigned file = 0; file < directory.files; file++)
+        out << *nextSize++ << ' ' << name(file) << ".txt\n";
+    }
+
+    if (next < directory.children.size()) {
+      const auto child = directory.children[next++];
+      out << "$ cd " << name(child) << '\n';
+      stack.emplace_back(child, 0);
+    } else {
+      stack.pop_back();
+      if (!stack.empty())
+        out << "$ cd ..\n";
+    }
+  }
+}
+
+// size = side of the forest
+void day8(std::ostream& out, unsigned size, Random& random) {
+  for (unsigned row = 0; row < size; row++) {
+    for (unsigned col = 0; col < size; col++)
+      out << static_cast<char>('0' + random.between(0, 9));
+    out << '\n';
+  }
+}
+
+// size = motions
+void day9(std::ostream& out, unsigned size, Random& random) {
+  static constexpr std::array<char, 4> DIRECTIONS{'U', 'R', 'D', 'L'};
+
+  for (unsigned motion = 0; motion < size; motion++)
+    out << DIRECTIONS[random.between(0, 3)] << ' ' << random.between(1, 20) << '\n';
+}
+
+// size = instructions, keeping the register within the screen
+void day10(std::ostream& out, unsigned size, Random& random) {
+  int reg = 1;
+  for (unsigned instr = 0; instr < size; instr++) {
+    if (random.chance(0.3)) {
+      out << "noop\n";
+    } else {
+      const auto value = random.between(-1 - reg, 40 - reg);
+      reg += value;
+      out << "addx " << value << '\n';
+    }
+  }
+}
+
+// size = monkeys
+void day11(std::ostream& out, unsigned size, Random& random) {
+  static const std::vector<unsigned> PRIMES{2, 3, 5, 7, 11, 13, 17, 19, 23};
+
+  size = std::max(size, 2u);
+  for (unsigned id = 0; id < size; id++) {
+    if (id > 0)
+      out << '\n';
+    out << "Monkey " << id << ":\n";
+
+    out << "  Starting items: ";
+    for (auto items = random.between(1, 6); items > 0; items--)
+      out << random.between(50, 99) << (items > 1 ? ", " : "\n");
+
+    out << "  Operation: new = old ";
+    if (const auto op = random.between(0, 3); op == 0)
+      out << "* old\n";
+    else if (op == 1)
+      out << "* " << random.between(2, 19) << '\n';
+    else
+      out << "+ " << random.between(1, 8) << '\n';
+
+    out << "  Test: divisible by " << random.pick(PRIMES) << '\n';
+    for (const auto* outcome : {"true", "false"}) {
+      int64_t target;
+      do {
+        target = random.between(0, size - 1);
+      } while (target == id);
+      out << "    If " << outcome << ": throw to monkey " << target << '\n';
+    }
+  }
+}
+
+// size = rows, with at least 26 columns so the slope from S to E is climbable
+void day12(std::ostream& out, unsigned size, Random& random) {
+  const unsigned rows = std::max(size, 1u);
+  const unsigned cols = std::max(size, 26u);
+  const unsigned path = rows / 2;
+
+  for (unsigned row = 0; row < rows; row++) {
+    for (unsigned col = 0; col < cols; col++) {
+      const int height = std::min<int>(25, col * 26 / cols);
+      if (row == path && col == 0)
+        out << 'S';
+      else if (row == path && col == cols - 1)
+        out << 'E';
+      else if (row == path)
+        out << static_cast<char>('a' + height);
+      else
+        out << static_cast<char>('a' + std::max<int>(0, height - random.between(0, 2)));
+    }
+    out << '\n';
+  }
+}
+
+// size = pairs of packets. None of them ties with a divider packet, which
+// would leave the place of the divider and so part 2 open.
+void day13(std::ostream& out, unsigned size, Random& random) {
+  std::string packet;
+  const std::function<void(unsigned)> list = [&](unsigned depth) {
+    packet += '[';
+    for (auto i = random.between(0, 4); i > 0; i--) {
+      if (depth < 4 && random.chance(0.3))
+        list(depth + 1);
+      else
+        packet += std::to_string(random.between(0, 10));
+      if (i > 1)
+        packet += ',';
+    }
+    packet += ']';
+  };
+
+  // Ties with [[2]] when it is nothing but 2 in lists of one, likewise for 6
+  const auto next = [&]() {
+    std::string number;
+    do {
+      packet.clear();
+      list(0);
+      number.clear();
+      std::ranges::copy_if(packet, std::back_inserter(number), [](char c) { return c != '[' && c != ']'; });
+    } while (number == "2" || number == "6");
+    out << packet << '\n';
+  };
+
+  for (unsigned pair = 0; pair < size; pair++) {
+    if (pair > 0)
+      out << '\n';
+    next();
+    next();
+  }
+}
+
+// size = rock paths, the cave deepens with the size. All rock stays right of
+// the diagonal x + y = 500, so the sand sliding down it can never pile up to
+// the source and part 1 always ends with sand flowing into the abyss.
+void day14(std::ostream& out, unsigned size, Random& random) {
+  const int depth = 10 + size / 10;
+
+  for (unsigned path = 0; path < size; path++) {
+    int y = random.between(2, depth);
+    int x = random.between(501 - y, 500 + depth);
+    out << x << ',' << y;
+    for (auto points = random.between(1, 4); points > 0; points--) {
+      if (points % 2)
+        x = std::max<int>(501 - y, x + random.between(-5, 5));
+      else
+        y = std::max<int>({2, 501 - x, y + static_cast<int>(random.between(-5, 5))});
+      out << " -> " << x << ',' << y;
+    }
+    out << '\n';
+  }
+}
+
+// size = sensors, at least 4. Four of them sit diagonally off a hidden point,
+// far enough out that their diamonds, each just short of it, cover all of the
+// searched area but the point, so part 2 always has exactly one answer. No
+// other sensor covers the point.
+void day15(std::ostream& out, unsigned size, Random& random) {
+  static constexpr int64_t MAX = 4000000;
+
+  const auto sensor = [&out](int64_t x, int64_t y, int64_t dx, int64_t dy) {
+    out << "Sensor at x=" << x << ", y=" << y << ": closest beacon is at x=" << x + dx << ", y=" << y + dy << '\n';
+  };
+
+  const int64_t hiddenX = random.between(0, MAX), hiddenY = random.between(0, MAX);
+  for (const auto& [sx, sy] : {std::pair{1, 1}, {1, -1}, {-1, 1}, {-1, -1}}) {
+    const int64_t radius = 2 * (MAX + 1) - 1;
+    sensor(hiddenX + sx * (MAX + 1), hiddenY + sy * (MAX + 1), -sx * radius, 0);
+  }
+
+  for (unsigned i = 4; i < size; i++) {
+    int64_t x, y, distance;
+    do {
+      x = random.between(0, MAX);
+      y = random.between(0, MAX);
+      distance = std::abs(x - hiddenX) + std::abs(y - hiddenY);
+    } while (distance < 2);
+
+    const auto radius = random.between(1, distance - 1);
+    const auto dx = random.between(-radius, radius);
+    sensor(x, y, dx, (random.chance(0.5) ? 1 : -1) * (radius - std::abs(dx)));
+  }
+}
+
+// size = valves, at most 676 since names are two letters. A quarter of them have a flow.
+void day16(std::ostream& out, unsigned size, Random& random) {
+  size = std::clamp(size, 2u, 26u * 26u);
+
+  const auto valve = [](unsigned id) {
+    return std::string{static_cast<char>('A' + id / 26), static_cast<char>('A' + id % 26)};
+  };
+
+  // Spanning tree plus a few extra tunnels
+  std::vector<std::set<unsigned>> tunnels(size);
+  const auto connect = [&tunnels](unsigned a, unsigned b) {
+    tunnels[a].insert(b);
+    tunnels[b].insert(a);
+  };
+  for (unsigned i = 1; i < size; i++)
+    connect(i, random.between(0, i - 1));
+  for (unsigned i = 0; i < size / 4; i++)
+    if (unsigned a = random.between(0, size - 1), b = random.between(0, size - 1); a != b)
+      connect(a, b);
+
+  for (unsigned id = 0; id < size; id++) {
+    const auto flow = id > 0 && random.chance(0.25) ? random.between(1, 25) : 0;
+    out << "Valve " << valve(id) << " has flow rate=" << flow << "; ";
+    out << (tunnels[id].size() == 1 ? "tunnel leads to valve " : "tunnels lead to valves ");
+    for (auto itr = tunnels[id].begin(); itr != tunnels[id].end(); itr++)
+      out << (itr == tunnels[id].begin() ? "" : ", ") << valve(*itr);
+    out << '\n';
+  }
+}
+
+// size = length of the jet pattern
+void day17(std::ostream& out, unsigned size, Random& random) {
+  for (unsigned i = 0; i < std::max(size, 1u); i++)
+    out << (random.chance(0.5) ? '<' : '>');
+  out << '\n';
+}
+
+// size = cubes, grown into one lump with pockets
+void day18(std::ostream& out, unsigned size, Random& random) {
+  static constexpr std::array<std::array<int, 3>, 6> OFFSETS{{{-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1}}};
+  static constexpr int64_t SPAN = 1 << 20;
+
+  const auto key = [](const std::array<int, 3>& c) {
+    return ((c[0] + SPAN / 2) * SPAN + c[1] + SPAN / 2) * SPAN + c[2] + SPAN / 2;
+  };
+
+  std::vector<std::array<int, 3>> cubes{{0, 0, 0}};
+  std::unordered_set<int64_t> taken{key(cubes.front())};
+  while (cubes.size() < size) {
+    auto cube = random.pick(cubes);
+    const auto& offset = OFFSETS[random.between(0, 5)];
+    for (unsigned i = 0; i < 3; i++)
+      cube[i] += offset[i];
+    if (taken.insert(key(cube)).second)
+      cubes.push_back(cube);
+  }
+
+  // Keep coordinates positive like the puzzle input
+  std::array<int, 3> min{};
+  for (const auto& cube : cubes)
+    for (unsigned i = 0; i < 3; i++)
+      min[i] = std::min(min[i], cube[i]);
+  for (const auto& cube : cubes)
+    out << cube[0] - min[0] << ',' << cube[1] - min[1] << ',' << cube[2] - min[2] << '\n';
+}
+
+// size = blueprints, at least the 3 that part 2 needs
+void day19(std::ostream& out, unsigned size, Random& random) {
+  for (unsigned id = 1; id <= std::max(size, 3u); id++) {
+    out << "Blueprint " << id << ": Each ore robot costs " << random.between(2, 4) << " ore. "
+        << "Each clay robot costs " << random.between(2, 4) << " ore. "
+        << "Each obsidian robot costs " << random.between(2, 4) << " ore and " << random.between(5, 20) << " clay. "
+        << "Each geode robot costs " << random.between(2, 4) << " ore and " << random.between(5, 20) << " obsidian.\n";
+  }
+}
+
+// size = numbers, exactly one of them zero
+void day20(std::ostream& out, unsigned size, Random& random) {
+  size = std::max(size, 1u);
+  const auto zero = random.between(0, size - 1);
+  for (unsigned i = 0; i < size; i++) {
+    int64_t value = 0;
+    while (i != zero && value == 0)
+      value = random.between(-10000, 10000);
+    out << value << '\n';
+  }
+}
+
+// size = monkeys, one fewer if even. root compares two subtrees of equal value, and every
+// division is exact, so the human's own number solves part 2 exactly.
+void day21(std::ostream& out, unsigned size, Random& random) {
+  static constexpr int64_t LIMIT = 1000000000000;
+
+  struct Monkey {
+    int left = -1;
+    int right = -1;
+    char op{};
+    int64_t value{};
+  };
+  std::vector<Monkey> monkeys;
+
+  // Random binary tree of the given (odd) number of monkeys
+  const std::function<int(unsigned)> build = [&](unsigned count) -> int {
+    assert(count % 2 == 1);
+    const int id = monkeys.size();
+    monkeys.emplace_back();
+    if (count > 1) {
+      const unsigned left = 2 * random.between(0, (count - 3) / 2) + 1;
+      const int l = build(left);
+      const int r = build(count - 1 - left);
+      monkeys[id].left = l;
+      monkeys[id].right = r;
+    }
+    return id;
+  };
+
+  // Picks operations bottom up that keep values small and divisions exact.
+  // Humn is never below a divisor, as the dividend would then have many
+  // solutions, or none when the quotient is 0.
+  int humn = -1;
+  std::vector<bool> withHumn; // Whether humn is below every monkey
+  const std::function<int64_t(int)> evaluate = [&](int id) -> int64_t {
+    withHumn.resize(monkeys.size());
+    auto& monkey = monkeys[id];
+    withHumn[id] = id == humn;
+    if (monkey.left < 0)
+      return monkey.value = random.between(1, 10);
+
+    const auto l = evaluate(monkey.left);
+    const auto r = evaluate(monkey.right);
+    withHumn[id] = withHumn[monkey.left] || withHumn[monkey.right];
+    std::vector<char> ops{'+', '-'};
+    if (l != 0 && r != 0 && std::abs(l) < LIMIT / std::abs(r))
+      ops.push_back('*');
+    if (r != 0 && l % r == 0 && !withHumn[monkey.right])
+      ops.push_back('/');
+
+    monkey.op = random.pick(ops);
+    switch (monkey.op) {
+      case '+':
+        return monkey.value = l + r;
+      case '-':
+        return monkey.value = l - r;
+      case '*':
+        return monkey.value = l * r;
+      default:
+        return monkey.value = l / r;
+    }
+  };
+
+  // Both sides of root need an odd number of monkeys, one less than the count
+  // together, so the count must be odd
+  unsigned count = std::max(size, 5u) - 2;
+  count -= count % 2 == 0;
+  const unsigned humanSide = 2 * random.between(0, (count - 1) / 2 - 1) + 1;
+  const int human = build(humanSide);
+  const int other = build(count - humanSide - 1);
+
+  // Humn is a random leaf on its side, which spans ids [human, other)
+  humn = human;
+  while (monkeys[humn].left >= 0)
+    humn = random.between(human, other - 1);
+
+  const auto target = evaluate(human);
+  const auto value = evaluate(other);
+
+  // Balance the other side with one more operation and a constant
+  const int constant = monkeys.size();
+  monkeys.push_back({-1, -1, 0, std::abs(target - value)});
+  const int balanced = monkeys.size();
+  monkeys.push_back({other, constant, target >= value ? '+' : '-', target});
+  if (target == value)
+    monkeys[constant].value = 1, monkeys[balanced].op = '*';
+
+  const int root = monkeys.size();
+  monkeys.push_back({human, balanced, '+', 0});
+
+  std::vector<std::string> names(monkeys.size());
+  std::unordered_set<std::string> used{"root", "humn"};
+  for (int id = 0; id < static_cast<int>(monkeys.size()); id++) {
+    if (id == root) {
+      names[id] = "root";
+    } else if (id == humn) {
+      names[id] = "humn";
+    } else {
+      do {
+        names[id] = name(random.between(0, 26 * 26 * 26 * 26 - 1), 4);
+      } while (!used.insert(names[id]).second);
+    }
+  }
+
+  std::vector<int> order(monkeys.size());
+  std::iota(order.begin(), order.end(), 0);
+  random.shuffle(order);
+  for (auto id : order) {
+    const auto& monkey = monkeys[id];
+    out << names[id] << ": ";
+    if (monkey.left < 0)
+      out << monkey.value << '\n';
+    else
+      out << names[monkey.left] << ' ' << monkey.op << ' ' << names[monkey.right] << '\n';
+  }
+}
+
+// size = path instructions. The map always has the 50 wide cube layout of the
+// puzzle input, since the cube folding in the solver is hardcoded for it.
+void day22(std::ostream& out, unsigned size, Random& random) {
+  static constexpr int SIDE = 50;
+  static const std::set<std::pair<int, int>> FACES{{0, 1}, {0, 2}, {1, 1}, {2, 0}, {2, 1}, {3, 0}};
+
+  for (int row = 0; row < 4 * SIDE; row++) {
+    std::string line;
+    for (int col = 0; col < 3 * SIDE; col++) {
+      if (!FACES.count({row / SIDE, col / SIDE}))
+        line += ' ';
+      else if (row == 0 && col == SIDE)
+        line += '.';
+      else
+        line += random.chance(0.05) ? '#' : '.';
+    }
+    line.erase(line.find_last_not_of(' ') + 1);
+    out << line << '\n';
+  }
+
+  out << '\n';
+  for (unsigned instr = 0; instr < size; instr++)
+    out << random.between(1, 50) << (random.chance(0.5) ? 'L' : 'R');
+  out << random.between(1, 50) << '\n';
+}
+
+// size = side of the grid, half of it elves
+void day23(std::ostream& out, unsigned size, Random& random) {
+  for (unsigned row = 0; row < size; row++) {
+    for (unsigned col = 0; col < size; col++)
+      out << (random.chance(0.5) ? '#' : '.');
+    out << '\n';
+  }
+}
+
+// size = width and height of the basin. The columns of the entrance and exit
+// have no vertical blizzards, like the puzzle input.
+void day24(std::ostream& out, unsigned size, Random& random) {
+  size = std::max(size, 2u);
+
+  out << "#." << std::string(size, '#') << '\n';
+  for (unsigned row = 0; row < size; row++) {
+    out << '#';
+    for (unsigned col = 0; col < size; col++) {
+      const bool vertical = col != 0 && col != size - 1;
+      if (!random.chance(0.4))
+        out << '.';
+      else if (vertical && random.chance(0.5))
+        out << (random.chance(0.5) ? '^' : 'v');
+      else
+        out << (random.chance(0.5) ? '<' : '>');
+    }
+    out << "#\n";
+  }
+  out << std::string(size, '#') << ".#\n";
+}
+
+// size = numbers
+void day25(std::ostream& out, unsigned size, Random& random) {
+  static constexpr std::array<char, 5> DIGITS{'=', '-', '0', '1', '2'};
+
+  for (unsigned i = 0; i < size; i++) {
+    out << DIGITS[random.between(3, 4)];
+    for (auto digits = random.between(0, 19); digits > 0; digits--)
+      out << DIGITS[random.between(0, 4)];
+    out << '\n';
+  }
+}
+
+const std::array<Generator, 25> DAYS{
+  day1, day2, day3, day4, day5, day6, day7, day8, day9, day10, day11, day12, day13,
+  day14, day15, day16, day17, day18, day19, day20, day21, day22, day23, day24, day25,
+};
+
+// Usage: generator --day=N --size=N [--seed=N]
+// Writes an input for the day to standard output, the meaning of size depends on the day
+int main(int argc, char* argv[]) {
+  aoc::options = aoc::Options(argc, argv);
+  const auto day = aoc::options.get("day", 0);
+  if (day < 1 || day > DAYS.size() || !aoc::options.has("size")) {
+    std::cerr << "Usage: generator --day=N --size=N [--seed=N]\n";
+    return 1;
+  }
+
+  std::ios::sync_with_stdio(false);
+  Random random(aoc::options.get("seed", 0));
+  DAYS[day - 1](std::cout, aoc::options.get("size", 0), random);
+
+  return 0;
+}
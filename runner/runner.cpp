@@ -0,0 +1,217 @@
+// Every standard header used by the days has to be included up front, since
+// the days themselves are included inside namespaces below
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <set>
+#include <span>
+#include <sstream>
+#include <stack>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif
+
+#include "../common/aoc.h"
+#include "../common/thread_pool.h"
+
+namespace day1 {
+#include "../day1/day1.cpp"
+}
+namespace day2 {
+#include "../day2/day2.cpp"
+}
+namespace day3 {
+#include "../day3/day3.cpp"
+}
+namespace day4 {
+#include "../day4/day4.cpp"
+}
+namespace day5 {
+#include "../day5/day4.cpp"
+}
+namespace day6 {
+#include "../day6/day6.cpp"
+}
+namespace day7 {
+#include "../day7/day7.cpp"
+}
+namespace day8 {
+#include "../day8/day8.cpp"
+}
+namespace day9 {
+#include "../day9/day9.cpp"
+}
+namespace day10 {
+#include "../day10/day10.cpp"
+}
+namespace day11 {
+#include "../day11/day11.cpp"
+}
+namespace day12 {
+#include "../day12/day12.cpp"
+}
+namespace day13 {
+#include "../day13/day13.cpp"
+}
+namespace day14 {
+#include "../day14/day14.cpp"
+}
+namespace day15 {
+#include "../day15/day15.cpp"
+}
+namespace day16 {
+#include "../day16/day16.cpp"
+}
+namespace day17 {
+#include "../day17/day17.cpp"
+}
+namespace day18 {
+#include "../day18/day18.cpp"
+}
+namespace day19 {
+#include "../day19/day19.cpp"
+}
+namespace day20 {
+#include "../day20/day20.cpp"
+}
+namespace day21 {
+#include "../day21/day21.cpp"
+}
+namespace day22 {
+#include "../day22/day22.cpp"
+}
+namespace day23 {
+#include "../day23/day23.cpp"
+}
+namespace day24 {
+#include "../day24/day24.cpp"
+}
+namespace day25 {
+#include "../day25/day25.cpp"
+}
+
+struct Job {
+  std::string result;
+  double time{}; // Milliseconds
+};
+
+struct Run {
+  unsigned day{};
+  std::optional<aoc::Input> input;
+  Job parse;
+  Job part1;
+  Job part2;
+  bool hasPart2{};
+};
+
+template <class F>
+auto timed(Job& job, F&& f) {
+  const auto start = std::chrono::steady_clock::now();
+  auto result = f();
+  job.time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  return result;
+}
+
+template <class F>
+void solve(Job& job, F&& f) {
+  std::ostringstream ss;
+  ss << timed(job, std::forward<F>(f));
+  job.result = ss.str();
+}
+
+using Schedule = std::function<void(aoc::ThreadPool&, Run&)>;
+
+// Parses on the pool, then solves both parts as separate jobs sharing the model
+template <class S>
+Schedule schedule(const S& solver) {
+  return [&solver](aoc::ThreadPool& pool, Run& run) {
+    run.hasPart2 = S::HAS_PART2;
+    pool.submit([&solver, &pool, &run]() {
+      const auto input = run.input->view();
+      using Model = decltype(aoc::parse(solver, input));
+      const auto model = std::make_shared<const Model>(timed(run.parse, [&]() { return aoc::parse(solver, input); }));
+
+      pool.submit([&solver, &run, model]() { solve(run.part1, [&]() { return solver.part1(*model); }); });
+      if constexpr (S::HAS_PART2)
+        pool.submit([&solver, &run, model]() { solve(run.part2, [&]() { return solver.part2(*model); }); });
+    });
+  };
+}
+
+const std::array<Schedule, 25> DAYS{
+  schedule(day1::solver), schedule(day2::solver), schedule(day3::solver), schedule(day4::solver), schedule(day5::solver),
+  schedule(day6::solver), schedule(day7::solver), schedule(day8::solver), schedule(day9::solver), schedule(day10::solver),
+  schedule(day11::solver), schedule(day12::solver), schedule(day13::solver), schedule(day14::solver), schedule(day15::solver),
+  schedule(day16::solver), schedule(day17::solver), schedule(day18::solver), schedule(day19::solver), schedule(day20::solver),
+  schedule(day21::solver), schedule(day22::solver), schedule(day23::solver), schedule(day24::solver), schedule(day25::solver),
+};
+
+std::ostream& operator<<(std::ostream& os, const Run& run) {
+  const auto print = [&os, &run](const std::string& name, const Job& job, bool result) {
+    os << "day" << std::left << std::setw(3) << run.day << std::setw(6) << name << std::right << std::fixed << std::setprecision(3) << std::setw(12) << job.time << " ms";
+    if (result)
+      os << "  " << job.result;
+    os << '\n';
+  };
+
+  if (!run.input) {
+    os << "day" << std::left << std::setw(3) << run.day << "no input\n";
+    return os;
+  }
+
+  print("parse", run.parse, false);
+  print("part1", run.part1, true);
+  if (run.hasPart2)
+    print("part2", run.part2, true);
+
+  return os;
+}
+
+// Usage: runner [--threads=N] [directory]
+// Solves every dayN.txt found in the directory (default current) concurrently
+int main(int argc, char* argv[]) {
+  aoc::options = aoc::Options(argc, argv);
+  const std::string directory = aoc::options.input.empty() ? "." : aoc::options.input;
+
+  std::vector<Run> runs(DAYS.size());
+  for (unsigned i = 0; i < runs.size(); i++) {
+    auto& run = runs[i];
+    run.day = i + 1;
+    run.input = aoc::Input::open(directory + "/day" + std::to_string(run.day) + ".txt");
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  aoc::ThreadPool pool(aoc::options.get("threads", std::thread::hardware_concurrency()));
+  for (unsigned i = 0; i < runs.size(); i++)
+    if (runs[i].input)
+      DAYS[i](pool, runs[i]);
+  pool.wait();
+  const auto total = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+  for (const auto& run : runs)
+    std::cout << run;
+  std::cout << "Total " << std::fixed << std::setprecision(3) << total << " ms on " << pool.size() << " threads\n";
+
+  return 0;
+}